@@ -11,6 +11,7 @@
 #include <score/plugins/documentdelegate/DocumentDelegateFactory.hpp>
 #include <score/selection/Selection.hpp>
 #include <score/tools/IdentifierGeneration.hpp>
+#include <score/tools/StartupTrace.hpp>
 #include <score/widgets/Pixmap.hpp>
 
 #include <core/application/ApplicationRegistrar.hpp>
@@ -360,11 +361,15 @@ void Application::init()
   m_presenter
       = new score::Presenter{appSettings, m_settings, m_projectSettings, m_view, this};
   // Plugins
-  GUIApplicationInterface::loadPluginData(m_settings, *m_presenter);
+  {
+    score::StartupTrace::Scope _{"Load plug-ins"};
+    GUIApplicationInterface::loadPluginData(m_settings, *m_presenter);
+  }
 
   // View
   if(appSettings.gui)
   {
+    score::StartupTrace::Scope _{"Show main window"};
 #if !defined(__EMSCRIPTEN__)
     m_view->show();
 #else
@@ -421,9 +426,13 @@ void Application::init()
 
 void Application::initDocuments()
 {
+  // Runs once the documents below are loaded or created, whichever path is taken
+  QTimer::singleShot(0, this, [this] { GUIApplicationInterface::afterStartup(); });
+
   auto& ctx = m_presenter->applicationContext();
   if(!appSettings.loadList.empty())
   {
+    score::StartupTrace::Scope _{"Load documents"};
     for(const auto& doc : appSettings.loadList)
       m_presenter->documentManager().loadFile(ctx, doc);
   }
@@ -12,6 +12,7 @@
 #include <score/plugins/qt_interfaces/FactoryInterface_QtInterface.hpp>
 #include <score/plugins/qt_interfaces/GUIApplicationPlugin_QtInterface.hpp>
 #include <score/plugins/settingsdelegate/SettingsDelegateFactory.hpp>
+#include <score/tools/StartupTrace.hpp>
 
 #include <core/application/ApplicationRegistrar.hpp>
 #include <core/messages/MessagesPanel.hpp>
@@ -23,6 +24,10 @@
 
 #include <QGuiApplication>
 #include <QModelIndex>
+
+#include <boost/core/demangle.hpp>
+
+#include <typeinfo>
 namespace score
 {
 ApplicationInterface* ApplicationInterface::m_instance;
@@ -74,6 +79,14 @@ static void loadDefaultPlugins(
     r.registerGUIApplicationPlugin(new UndoApplicationPlugin{ctx});
 }
 
+template <typename T>
+static std::string traceName(const char* step, const T& plugin)
+{
+  if(!StartupTrace::enabled())
+    return {};
+  return step + boost::core::demangle(typeid(plugin).name());
+}
+
 void GUIApplicationInterface::loadPluginData(
     score::Settings& settings, score::Presenter& presenter)
 {
@@ -83,7 +96,10 @@ void GUIApplicationInterface::loadPluginData(
       presenter.actionManager()};
   loadDefaultPlugins(ctx, registrar, settings, presenter);
 
-  score::PluginLoader::loadPlugins(registrar, ctx);
+  {
+    StartupTrace::Scope _{"Register plug-ins"};
+    score::PluginLoader::loadPlugins(registrar, ctx);
+  }
 
   // Now rehash our various hash tables
   presenter.optimize();
@@ -98,26 +114,33 @@ void GUIApplicationInterface::loadPluginData(
 #else
   QSettings s;
 #endif
-  for(auto& elt : ctx.interfaces<score::SettingsDelegateFactoryList>())
   {
-    settings.setupSettingsPlugin(s, ctx, elt);
+    StartupTrace::Scope _{"Load settings"};
+    for(auto& elt : ctx.interfaces<score::SettingsDelegateFactoryList>())
+    {
+      settings.setupSettingsPlugin(s, ctx, elt);
+    }
   }
 
   if(presenter.view())
   {
+    StartupTrace::Scope _{"Setup GUI"};
     presenter.setupGUI();
   }
   for(score::ApplicationPlugin* app_plug : ctx.applicationPlugins())
   {
+    StartupTrace::Scope _{traceName("Initialize ", *app_plug)};
     app_plug->initialize();
   }
   for(score::GUIApplicationPlugin* app_plug : ctx.guiApplicationPlugins())
   {
+    StartupTrace::Scope _{traceName("Initialize ", *app_plug)};
     app_plug->initialize();
   }
 
   if(presenter.view())
   {
+    StartupTrace::Scope _{"Setup panels"};
     for(auto& panel_fac : ctx.interfaces<score::PanelDelegateFactoryList>())
     {
       registrar.registerPanel(panel_fac);
@@ -136,6 +159,23 @@ void GUIApplicationInterface::loadPluginData(
   }
 }
 
+void GUIApplicationInterface::afterStartup()
+{
+  auto& ctx = context();
+  for(score::ApplicationPlugin* app_plug : ctx.applicationPlugins())
+  {
+    StartupTrace::Scope _{traceName("After startup: ", *app_plug)};
+    app_plug->afterStartup();
+  }
+  for(score::GUIApplicationPlugin* app_plug : ctx.guiApplicationPlugins())
+  {
+    StartupTrace::Scope _{traceName("After startup: ", *app_plug)};
+    app_plug->afterStartup();
+  }
+
+  StartupTrace::finish();
+}
+
 void GUIApplicationInterface::registerPlugin(Plugin_QtInterface& p)
 {
   auto plugin = &p;
@@ -59,6 +59,14 @@ public:
    */
   void loadPluginData(score::Settings& settings, score::Presenter& presenter);
 
+  /**
+   * @brief afterStartup Runs the deferred initialization of the plug-ins.
+   *
+   * To be called once the first documents have been opened.
+   * \see ApplicationPlugin::afterStartup
+   */
+  void afterStartup();
+
   void registerPlugin(score::Plugin_QtInterface&);
 
   void requestExit();
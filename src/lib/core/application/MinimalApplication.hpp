@@ -44,6 +44,7 @@ public:
         = new score::Presenter{m_applicationSettings, m_settings, m_pset, nullptr, this};
 
     GUIApplicationInterface::loadPluginData(m_settings, *m_presenter);
+    GUIApplicationInterface::afterStartup();
   }
 
   ~MinimalApplication() override
@@ -100,6 +101,7 @@ public:
         = new score::Presenter{m_applicationSettings, m_settings, m_pset, m_view, this};
 
     GUIApplicationInterface::loadPluginData(m_settings, *m_presenter);
+    GUIApplicationInterface::afterStartup();
 
     m_view->show();
   }
@@ -7,6 +7,8 @@
 #include <core/application/CommandBackupFile.hpp>
 #include <core/application/OpenDocumentsFile.hpp>
 
+#include <score/tools/AsyncFileWriter.hpp>
+
 #include <QFile>
 #include <QSettings>
 #include <QVariant>
@@ -16,11 +18,7 @@ score::DocumentBackupManager::DocumentBackupManager(
     : QObject{&doc}
     , m_doc{doc}
 {
-  m_modelFile.open();
-  m_modelFile.resize(0);
-  m_modelFile.reset();
-  m_modelFile.write(data);
-  m_modelFile.flush();
+  writeModelData(data);
 
   m_commandFile = new CommandBackupFile{doc.commandStack(), this};
 }
@@ -30,17 +28,16 @@ score::DocumentBackupManager::DocumentBackupManager(
     : QObject{&doc}
     , m_doc{doc}
 {
-  m_modelFile.open();
-  m_modelFile.resize(0);
-  m_modelFile.reset();
-  m_modelFile.write(prev.doc);
-  m_modelFile.flush();
+  writeModelData(prev.doc);
 
   m_commandFile = new CommandBackupFile{doc.commandStack(), prev.commands, this};
 }
 
 score::DocumentBackupManager::~DocumentBackupManager()
 {
+  // Waits for the backup to be written before removing it
+  m_modelWriter.reset();
+
 #if !defined(__EMSCRIPTEN__)
   // If we are getting there, it means that we could close the document
   // normally thus we can just remove the associated files
@@ -57,6 +54,18 @@ score::DocumentBackupManager::~DocumentBackupManager()
 #endif
 }
 
+void score::DocumentBackupManager::writeModelData(const QByteArray& data)
+{
+  // The temporary file only provides a unique name, the data is written
+  // from another thread
+  m_modelFile.open();
+  m_modelFile.close();
+
+  m_modelWriter = std::make_unique<AsyncFileWriter>(m_modelFile.fileName());
+  m_modelWriter->write(data);
+  m_modelWriter->end();
+}
+
 QTemporaryFile& score::DocumentBackupManager::crashDataFile()
 {
   return m_modelFile;
@@ -3,8 +3,11 @@
 #include <QObject>
 #include <QTemporaryFile>
 
+#include <memory>
+
 namespace score
 {
+class AsyncFileWriter;
 class CommandBackupFile;
 class Document;
 struct RestorableDocument;
@@ -51,11 +54,13 @@ public:
   void updateBackupData();
 
 private:
+  void writeModelData(const QByteArray& data);
   QTemporaryFile& crashDataFile();
   CommandBackupFile& crashCommandFile();
 
   score::Document& m_doc;
   QTemporaryFile m_modelFile;
+  std::unique_ptr<AsyncFileWriter> m_modelWriter;
   CommandBackupFile* m_commandFile{};
 };
 }
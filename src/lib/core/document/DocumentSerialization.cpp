@@ -12,6 +12,7 @@
 #include <score/plugins/documentdelegate/DocumentDelegateModel.hpp>
 #include <score/plugins/documentdelegate/plugin/DocumentPlugin.hpp>
 #include <score/plugins/documentdelegate/plugin/DocumentPluginCreator.hpp>
+#include <score/serialization/BinaryChunks.hpp>
 #include <score/serialization/DataStreamVisitor.hpp>
 #include <score/serialization/JSONVisitor.hpp>
 #include <score/tools/File.hpp>
@@ -101,47 +102,32 @@ void Document::saveAsJson(JSONObject::Serializer& writer)
 
 QByteArray Document::saveAsByteArray()
 {
-  using namespace std;
-  QByteArray global;
-  QDataStream writer(&global, QIODevice::WriteOnly);
+  // Each part of the document goes in its own chunk so that it can be
+  // verified and read independently.
+  BinaryChunkWriter writer;
 
   // Save the document
-  auto docByteArray = saveDocumentModelAsByteArray();
+  writer.add(BinaryChunk::DocumentModel, saveDocumentModelAsByteArray());
 
   // Save the document plug-ins
-  QVector<QPair<QByteArray, QByteArray>> documentPluginModels;
-
   for(const auto& plugin : model().pluginModels())
   {
     if(auto serializable_plugin = qobject_cast<SerializableDocumentPlugin*>(plugin))
     {
-      //static_assert(
-      //    is_identified_object<SerializableDocumentPlugin>::value, "");
-      //static_assert(
-      //    (is_identified_object<SerializableDocumentPlugin>::value
-      //     && !is_entity<SerializableDocumentPlugin>::value
-      //     && abstract_base<SerializableDocumentPlugin>
-      //     && !is_custom_serialized<SerializableDocumentPlugin>::value),
-      //    "");
       static_assert(
           (abstract_base<SerializableDocumentPlugin>
            && !is_custom_serialized<SerializableDocumentPlugin>::value),
           "");
-      QByteArray arr_before, arr_after;
-      DataStream::Serializer s_before{&arr_before};
-      s_before.readFrom(*serializable_plugin);
-      documentPluginModels.push_back({std::move(arr_before), std::move(arr_after)});
+      QByteArray arr;
+      DataStream::Serializer s{&arr};
+      s.readFrom(*serializable_plugin);
+      writer.add(BinaryChunk::DocumentPlugin, std::move(arr));
     }
   }
 
-  writer << docByteArray << documentPluginModels;
-
-  auto hash = QCryptographicHash::hash(global, QCryptographicHash::Algorithm::Sha512);
-  writer << hash;
-
   // Indicate in the stack that the current position is saved
   m_commandStack.markCurrentIndexAsSaved();
-  return global;
+  return writer.finish();
 }
 
 // Load document
@@ -298,21 +284,53 @@ Document::Document(
 void DocumentModel::loadDocumentAsByteArray(
     score::DocumentContext& ctx, const QByteArray& data, DocumentDelegateFactory& fact)
 {
-  // Deserialize the first parts
+  // Note: data is generally a memory-mapped file ; the chunks are views
+  // over the mapping and are never copied.
   QByteArray doc;
-  QVector<QPair<QByteArray, QByteArray>> documentPluginModels;
-  QByteArray hash;
+  std::vector<QByteArray> documentPluginModels;
 
-  QDataStream wr{data};
-  wr >> doc >> documentPluginModels >> hash;
+  if(BinaryChunkReader::isChunked(data))
+  {
+    BinaryChunkReader reader{data};
+    if(!reader.valid() || !reader.verify())
+      throw std::runtime_error("Invalid file.");
 
-  // Perform hash verification
-  QByteArray verif_arr;
-  QDataStream writer(&verif_arr, QIODevice::WriteOnly);
-  writer << doc << documentPluginModels;
-  if(QCryptographicHash::hash(verif_arr, QCryptographicHash::Algorithm::Sha512) != hash)
+    for(const auto& chunk : reader.chunks())
+    {
+      switch(chunk.kind)
+      {
+        case BinaryChunk::DocumentModel:
+          doc = chunk.data;
+          break;
+        case BinaryChunk::DocumentPlugin:
+          documentPluginModels.push_back(chunk.data);
+          break;
+        default:
+          break;
+      }
+    }
+  }
+  else
   {
-    throw std::runtime_error("Invalid file.");
+    // Pre-chunked format: a single QDataStream with a global hash
+    QVector<QPair<QByteArray, QByteArray>> legacyPluginModels;
+    QByteArray hash;
+
+    QDataStream wr{data};
+    wr >> doc >> legacyPluginModels >> hash;
+
+    // Perform hash verification
+    QByteArray verif_arr;
+    QDataStream writer(&verif_arr, QIODevice::WriteOnly);
+    writer << doc << legacyPluginModels;
+    if(QCryptographicHash::hash(verif_arr, QCryptographicHash::Algorithm::Sha512)
+       != hash)
+    {
+      throw std::runtime_error("Invalid file.");
+    }
+
+    for(auto& plug : legacyPluginModels)
+      documentPluginModels.push_back(std::move(plug.first));
   }
 
   // Set the id
@@ -326,20 +344,12 @@ void DocumentModel::loadDocumentAsByteArray(
   // in order to be deserialized. (e.g. the groups for the network)
   // First load the plugin models
 
-  const auto plug_n = documentPluginModels.size();
-
   auto& plugin_factories = ctx.app.interfaces<DocumentPluginFactoryList>();
-  std::vector<score::DocumentPlugin*> docs(plug_n, nullptr);
-
-  for(int i = 0; i < plug_n; i++)
+  for(const auto& plugin_raw : documentPluginModels)
   {
-    const auto& plugin_raw = documentPluginModels[i];
-
-    DataStream::Deserializer plug_writer{plugin_raw.first};
+    DataStream::Deserializer plug_writer{plugin_raw};
     auto plug = deserialize_interface(plugin_factories, plug_writer, ctx, this);
 
-    qDebug() << plug;
-    docs[i] = plug;
     if(plug)
     {
       this->addPluginModel(plug);
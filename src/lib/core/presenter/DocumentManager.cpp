@@ -9,6 +9,7 @@
 #include <score/plugins/documentdelegate/plugin/DocumentPlugin.hpp>
 #include <score/plugins/panel/PanelDelegate.hpp>
 #include <score/plugins/qt_interfaces/PluginRequirements_QtInterface.hpp>
+#include <score/tools/AsyncFileWriter.hpp>
 #include <score/tools/File.hpp>
 #include <score/tools/IdentifierGeneration.hpp>
 #include <score/tools/std/Optional.hpp>
@@ -70,6 +71,31 @@ struct hash<score::LoadedPluginVersions>
 namespace
 {
 
+static bool writeDocument(score::Document& doc, const QString& savename)
+{
+  score::AsyncFileWriter f{savename};
+  if(f.failed())
+    return false;
+
+  if(savename.indexOf(".scorebin") != -1)
+  {
+    f.write(doc.saveAsByteArray());
+  }
+  else
+  {
+    // The JSON is streamed to disk by chunks while it is being generated:
+    // the complete document is never held in memory, and the disk writes
+    // happen on another thread.
+    JSONReader w;
+    w.buffer.Reserve(w.flushThreshold + 64 * 1024);
+    w.sink = [&f](std::string_view data) { f.write(data); };
+    doc.saveAsJson(w);
+    w.flush();
+  }
+
+  return f.commit();
+}
+
 static QDir getDialogDirectory(score::Document* current)
 {
   if(current)
@@ -305,22 +331,7 @@ bool DocumentManager::saveDocument(Document& doc)
   }
   else if(savename.size() != 0)
   {
-    QSaveFile f{savename};
-    f.open(QIODevice::WriteOnly);
-    if(savename.indexOf(".scorebin") != -1)
-    {
-      f.write(doc.saveAsByteArray());
-    }
-    else
-    {
-      JSONReader w;
-      w.buffer.Reserve(1024 * 1024 * 16);
-      doc.saveAsJson(w);
-
-      f.write(w.buffer.GetString(), w.buffer.GetSize());
-    }
-
-    if(f.commit())
+    if(writeDocument(doc, savename))
     {
       m_recentFiles->addRecentFile(savename);
       saveRecentFilesState();
@@ -375,21 +386,8 @@ bool DocumentManager::saveDocumentAs(Document& doc)
           savename += ".score";
       }
 
-      QSaveFile f{savename};
-      f.open(QIODevice::WriteOnly);
       doc.metadata().setFileName(savename);
-      if(savename.indexOf(".scorebin") != -1)
-        f.write(doc.saveAsByteArray());
-      else
-      {
-        JSONReader w;
-        w.buffer.Reserve(1024 * 1024 * 16);
-        doc.saveAsJson(w);
-
-        f.write(w.buffer.GetString(), w.buffer.GetSize());
-      }
-
-      if(f.commit())
+      if(writeDocument(doc, savename))
       {
         m_recentFiles->addRecentFile(savename);
         saveRecentFilesState();
@@ -27,6 +27,8 @@ ApplicationPlugin::ApplicationPlugin(const ApplicationContext& ctx)
 
 void ApplicationPlugin::initialize() { }
 
+void ApplicationPlugin::afterStartup() { }
+
 GUIApplicationPlugin::GUIApplicationPlugin(const score::GUIApplicationContext& app)
     : context{app}
 {
@@ -41,6 +43,8 @@ GUIElements GUIApplicationPlugin::makeGUIElements()
 
 void GUIApplicationPlugin::initialize() { }
 
+void GUIApplicationPlugin::afterStartup() { }
+
 Document* GUIApplicationPlugin::currentDocument() const
 {
   return context.documents.currentDocument();
@@ -40,6 +40,15 @@ public:
    */
   virtual void initialize();
 
+  /**
+   * @brief afterStartup
+   *
+   * This method will be called once the first documents have been opened.
+   * Work which is not needed to load a document, such as scanning for
+   * plug-ins or devices, goes here so that it does not delay startup.
+   */
+  virtual void afterStartup();
+
   virtual ~ApplicationPlugin();
 
   const score::ApplicationContext& context;
@@ -116,6 +125,13 @@ public:
    */
   virtual void initialize();
 
+  /**
+   * @brief afterStartup
+   *
+   * \see ApplicationPlugin::afterStartup
+   */
+  virtual void afterStartup();
+
   /**
    * @brief currentDocument
    * @return Shortcut to get the active (visible) document.
@@ -0,0 +1,141 @@
+#include "BinaryChunks.hpp"
+
+#include <score/tools/ThreadPool.hpp>
+
+#include <QCryptographicHash>
+#include <QtEndian>
+
+#include <atomic>
+#include <cstring>
+
+namespace score
+{
+namespace
+{
+static constexpr char chunk_magic[8] = {'S', 'C', 'O', 'R', 'E', 'B', 'I', 'N'};
+static constexpr uint32_t chunk_format_version = 1;
+static constexpr int64_t header_size = 8 + 4 + 4;
+static constexpr int64_t hash_size = 32;
+static constexpr int64_t toc_entry_size = 4 + 4 + 8 + 8 + hash_size;
+static constexpr int64_t chunk_alignment = 16;
+
+static QByteArray hashChunk(const QByteArray& data)
+{
+  return QCryptographicHash::hash(data, QCryptographicHash::Sha256);
+}
+
+static int64_t align(int64_t v) noexcept
+{
+  return (v + chunk_alignment - 1) & ~(chunk_alignment - 1);
+}
+
+template <typename T>
+void put(char*& p, T v) noexcept
+{
+  qToLittleEndian(v, p);
+  p += sizeof(T);
+}
+
+template <typename T>
+T get(const char*& p) noexcept
+{
+  T v = qFromLittleEndian<T>(p);
+  p += sizeof(T);
+  return v;
+}
+}
+
+void BinaryChunkWriter::add(uint32_t kind, QByteArray data)
+{
+  auto hash = hashChunk(data);
+  m_chunks.push_back({kind, std::move(data), std::move(hash)});
+}
+
+QByteArray BinaryChunkWriter::finish() const
+{
+  const int64_t count = m_chunks.size();
+  int64_t total = align(header_size + count * toc_entry_size);
+  for(auto& chunk : m_chunks)
+    total = align(total + chunk.data.size());
+
+  QByteArray res(total, Qt::Uninitialized);
+  std::memset(res.data(), 0, total);
+
+  char* p = res.data();
+  std::memcpy(p, chunk_magic, sizeof(chunk_magic));
+  p += sizeof(chunk_magic);
+  put<uint32_t>(p, chunk_format_version);
+  put<uint32_t>(p, uint32_t(count));
+
+  int64_t offset = align(header_size + count * toc_entry_size);
+  for(auto& chunk : m_chunks)
+  {
+    put<uint32_t>(p, chunk.kind);
+    put<uint32_t>(p, 0);
+    put<uint64_t>(p, offset);
+    put<uint64_t>(p, chunk.data.size());
+    std::memcpy(p, chunk.hash.constData(), hash_size);
+    p += hash_size;
+
+    std::memcpy(res.data() + offset, chunk.data.constData(), chunk.data.size());
+    offset = align(offset + chunk.data.size());
+  }
+
+  return res;
+}
+
+BinaryChunkReader::BinaryChunkReader(const QByteArray& data)
+{
+  if(!isChunked(data))
+    return;
+
+  const char* p = data.constData() + sizeof(chunk_magic);
+  const auto version = get<uint32_t>(p);
+  const auto count = get<uint32_t>(p);
+  if(version > chunk_format_version)
+    return;
+  if(header_size + int64_t(count) * toc_entry_size > data.size())
+    return;
+
+  m_chunks.reserve(count);
+  for(uint32_t i = 0; i < count; i++)
+  {
+    BinaryChunk chunk;
+    chunk.kind = get<uint32_t>(p);
+    (void)get<uint32_t>(p);
+    const auto offset = get<uint64_t>(p);
+    const auto size = get<uint64_t>(p);
+    chunk.hash = QByteArray::fromRawData(p, hash_size);
+    p += hash_size;
+
+    if(offset > uint64_t(data.size()) || size > uint64_t(data.size()) - offset)
+      return;
+
+    chunk.data = QByteArray::fromRawData(data.constData() + offset, size);
+    m_chunks.push_back(std::move(chunk));
+  }
+
+  m_valid = true;
+}
+
+bool BinaryChunkReader::isChunked(const QByteArray& data) noexcept
+{
+  return data.size() >= header_size
+         && std::memcmp(data.constData(), chunk_magic, sizeof(chunk_magic)) == 0;
+}
+
+bool BinaryChunkReader::verify() const
+{
+  if(!m_valid)
+    return false;
+
+  // This thread checks chunks too, so it never waits behind other pool tasks
+  std::atomic_bool ok = true;
+  const auto check = [this, &ok](int i) {
+    if(hashChunk(m_chunks[i].data) != m_chunks[i].hash)
+      ok = false;
+  };
+  parallel_for(std::ssize(m_chunks), check, TaskPool::Priority::High);
+  return ok;
+}
+}
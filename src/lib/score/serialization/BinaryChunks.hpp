@@ -0,0 +1,66 @@
+#pragma once
+#include <QByteArray>
+
+#include <score_lib_base_export.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace score
+{
+/**
+ * @brief Chunked binary container used by .scorebin files.
+ *
+ * Layout:
+ * - "SCOREBIN" magic, u32 format version, u32 chunk count
+ * - table of contents: for each chunk, u32 kind, u32 flags, u64 offset,
+ *   u64 size, 32-byte SHA-256 of the chunk data
+ * - chunk data, each chunk aligned on 16 bytes.
+ *
+ * All integers are little-endian.
+ * Reading does not copy anything: when given a memory-mapped file,
+ * the chunks are views over the mapping. Each chunk carries its own hash,
+ * so the chunks can be verified independently and concurrently.
+ */
+struct SCORE_LIB_BASE_EXPORT BinaryChunk
+{
+  enum Kind : uint32_t
+  {
+    DocumentModel = 1,
+    DocumentPlugin = 2,
+  };
+
+  uint32_t kind{};
+  QByteArray data;
+  QByteArray hash;
+};
+
+class SCORE_LIB_BASE_EXPORT BinaryChunkWriter
+{
+public:
+  void add(uint32_t kind, QByteArray data);
+  QByteArray finish() const;
+
+private:
+  std::vector<BinaryChunk> m_chunks;
+};
+
+class SCORE_LIB_BASE_EXPORT BinaryChunkReader
+{
+public:
+  // data must outlive the reader and the chunks it returns
+  explicit BinaryChunkReader(const QByteArray& data);
+
+  static bool isChunked(const QByteArray& data) noexcept;
+
+  bool valid() const noexcept { return m_valid; }
+  const std::vector<BinaryChunk>& chunks() const noexcept { return m_chunks; }
+
+  // Checks the hashes of all the chunks, in parallel.
+  bool verify() const;
+
+private:
+  std::vector<BinaryChunk> m_chunks;
+  bool m_valid{};
+};
+}
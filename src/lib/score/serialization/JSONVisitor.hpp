@@ -16,6 +16,8 @@
 
 #include <QDebug>
 
+#include <functional>
+#include <string_view>
 #include <verdigris>
 
 template <typename T>
@@ -197,10 +199,29 @@ public:
         read(obj);
       }
     }
+
+    if(sink && buffer.GetSize() >= flushThreshold)
+      flush();
+  }
+
+  //! Hands the content of the buffer to the sink and clears it.
+  void flush()
+  {
+    if(sink && buffer.GetSize() > 0)
+    {
+      sink(std::string_view{buffer.GetString(), buffer.GetSize()});
+      buffer.Clear();
+    }
   }
 
   rapidjson::StringBuffer buffer;
   JsonWriter stream{buffer};
+
+  //! When set, the serialized data is streamed to the sink
+  //! every flushThreshold bytes instead of being accumulated in buffer,
+  //! which then never contains the complete document.
+  std::function<void(std::string_view)> sink;
+  std::size_t flushThreshold{1024 * 1024};
   struct assigner;
   struct fake_obj
   {
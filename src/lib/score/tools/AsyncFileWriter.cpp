@@ -0,0 +1,110 @@
+#include "AsyncFileWriter.hpp"
+
+#include <ossia/detail/thread.hpp>
+
+#include <QDebug>
+
+#include <algorithm>
+#include <cstring>
+
+namespace score
+{
+
+AsyncFileWriter::AsyncFileWriter(const QString& path, int maxPendingChunks)
+    : m_file{path}
+{
+  // Opened here so that the caller can give up before generating the data
+  if(!m_file.open(QIODevice::WriteOnly))
+  {
+    qDebug() << "Cannot write" << path << ":" << m_file.errorString();
+    m_failed = true;
+  }
+
+  for(int i = 0; i < std::max(1, maxPendingChunks); i++)
+    m_free.enqueue(QByteArray{});
+
+  m_thread = std::thread{[this] {
+    ossia::set_thread_name("ossia file writer");
+
+    QByteArray chunk;
+    for(;;)
+    {
+      m_pending.wait_dequeue(chunk);
+
+      // An empty chunk marks the end of the file
+      if(chunk.isEmpty())
+        break;
+
+      if(!m_failed && m_file.write(chunk) != chunk.size())
+      {
+        qDebug() << "Cannot write" << m_file.fileName() << ":" << m_file.errorString();
+        m_failed = true;
+      }
+
+      // Keeps the capacity of the buffers which were copied into
+      chunk.resize(0);
+      m_free.enqueue(std::move(chunk));
+    }
+
+    if(m_ended && !m_failed)
+      m_ok = m_file.commit();
+    else
+      m_file.cancelWriting();
+  }};
+}
+
+AsyncFileWriter::~AsyncFileWriter()
+{
+  finish();
+}
+
+void AsyncFileWriter::write(std::string_view data)
+{
+  if(data.empty() || m_failed)
+    return;
+
+  QByteArray chunk;
+  m_free.wait_dequeue(chunk);
+  chunk.resize(qsizetype(data.size()));
+  std::memcpy(chunk.data(), data.data(), data.size());
+  m_pending.enqueue(std::move(chunk));
+}
+
+void AsyncFileWriter::write(QByteArray data)
+{
+  if(data.isEmpty() || m_failed)
+    return;
+
+  // Still takes a slot so that the number of chunks in flight stays bounded
+  QByteArray slot;
+  m_free.wait_dequeue(slot);
+  m_pending.enqueue(std::move(data));
+}
+
+void AsyncFileWriter::end()
+{
+  if(!m_ended.exchange(true))
+    m_pending.enqueue(QByteArray{});
+}
+
+bool AsyncFileWriter::commit()
+{
+  end();
+  finish();
+  return m_ok;
+}
+
+void AsyncFileWriter::finish()
+{
+  if(m_thread.joinable())
+  {
+    // Without end(), the writes are abandoned
+    if(!m_ended.exchange(true))
+    {
+      m_failed = true;
+      m_pending.enqueue(QByteArray{});
+    }
+    m_thread.join();
+  }
+}
+}
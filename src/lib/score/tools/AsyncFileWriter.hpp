@@ -0,0 +1,58 @@
+#pragma once
+#include <QByteArray>
+#include <QSaveFile>
+#include <QString>
+
+#include <blockingconcurrentqueue.h>
+#include <score_lib_base_export.h>
+
+#include <atomic>
+#include <string_view>
+#include <thread>
+
+namespace score
+{
+/**
+ * @brief Writes a file from a background thread.
+ *
+ * Data is handed over in chunks which are copied into a fixed set of
+ * reusable buffers: when all of them are in flight, write() waits for the
+ * disk, so that memory usage stays bounded whatever the size of the file.
+ * Data which is already in a QByteArray is passed along without copy.
+ *
+ * The file is replaced atomically (through QSaveFile) once all the data is
+ * written, after end() or commit() ; if the object is destroyed before, the
+ * previous file is left untouched. After an error, the data is dropped.
+ */
+class SCORE_LIB_BASE_EXPORT AsyncFileWriter
+{
+public:
+  explicit AsyncFileWriter(const QString& path, int maxPendingChunks = 8);
+  AsyncFileWriter(const AsyncFileWriter&) = delete;
+  AsyncFileWriter& operator=(const AsyncFileWriter&) = delete;
+  ~AsyncFileWriter();
+
+  //! True if the file could not be opened or a write failed.
+  bool failed() const noexcept { return m_failed; }
+
+  void write(std::string_view data);
+  void write(QByteArray data);
+
+  //! Marks the end of the data: the file is replaced without waiting.
+  void end();
+
+  //! Waits until all the data is on disk and replaces the file.
+  bool commit();
+
+private:
+  void finish();
+
+  QSaveFile m_file;
+  moodycamel::BlockingConcurrentQueue<QByteArray> m_free;
+  moodycamel::BlockingConcurrentQueue<QByteArray> m_pending;
+  std::thread m_thread;
+  std::atomic_bool m_failed{};
+  std::atomic_bool m_ended{};
+  std::atomic_bool m_ok{};
+};
+}
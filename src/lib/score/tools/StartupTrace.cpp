@@ -0,0 +1,119 @@
+#include "StartupTrace.hpp"
+
+#include <QDebug>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <algorithm>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace score
+{
+namespace
+{
+struct TraceEvent
+{
+  std::string name;
+  const char* category{};
+  std::size_t thread{};
+  std::chrono::steady_clock::time_point begin;
+  std::chrono::steady_clock::time_point end;
+};
+
+struct TraceState
+{
+  const QString path = qEnvironmentVariable("SCORE_STARTUP_TRACE");
+  const std::chrono::steady_clock::time_point origin = std::chrono::steady_clock::now();
+
+  std::mutex mutex;
+  std::vector<TraceEvent> events;
+  bool active = !path.isEmpty();
+};
+
+static TraceState& state()
+{
+  static TraceState s;
+  return s;
+}
+}
+
+bool StartupTrace::enabled() noexcept
+{
+  static const bool enabled = [] {
+    // Timestamps are relative to the first time this gets called
+    const bool enabled = !qEnvironmentVariableIsEmpty("SCORE_STARTUP_TRACE");
+    if(enabled)
+      state();
+    return enabled;
+  }();
+  return enabled;
+}
+
+void StartupTrace::record(
+    std::string name, const char* category, std::chrono::steady_clock::time_point begin,
+    std::chrono::steady_clock::time_point end)
+{
+  auto& s = state();
+  std::lock_guard lck{s.mutex};
+  if(!s.active)
+    return;
+
+  const auto thread = std::hash<std::thread::id>{}(std::this_thread::get_id());
+  s.events.push_back({std::move(name), category, thread, begin, end});
+}
+
+void StartupTrace::finish()
+{
+  if(!enabled())
+    return;
+
+  auto& s = state();
+  std::vector<TraceEvent> events;
+  {
+    std::lock_guard lck{s.mutex};
+    if(!s.active)
+      return;
+    s.active = false;
+    events = std::move(s.events);
+  }
+
+  using namespace std::chrono;
+  auto us = [&](steady_clock::time_point t) {
+    return double(duration_cast<microseconds>(t - s.origin).count());
+  };
+
+  QJsonArray trace;
+  for(const auto& e : events)
+  {
+    trace.append(QJsonObject{
+        {"name", QString::fromStdString(e.name)},
+        {"cat", e.category},
+        {"ph", "X"},
+        {"ts", us(e.begin)},
+        {"dur", us(e.end) - us(e.begin)},
+        {"pid", 1},
+        {"tid", double(e.thread % (1 << 30))}});
+  }
+
+  QFile f{s.path};
+  if(f.open(QIODevice::WriteOnly))
+    f.write(QJsonDocument{QJsonObject{{"traceEvents", trace}}}.toJson());
+  else
+    qDebug() << "Could not write the startup trace: " << s.path;
+
+  std::sort(events.begin(), events.end(), [](const auto& lhs, const auto& rhs) {
+    return (lhs.end - lhs.begin) > (rhs.end - rhs.begin);
+  });
+  for(std::size_t i = 0; i < std::min(std::size_t(15), events.size()); i++)
+  {
+    const auto& e = events[i];
+    qDebug() << "[startup]" << duration_cast<milliseconds>(e.end - e.begin).count()
+             << "ms:" << e.name.c_str();
+  }
+}
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include <score_lib_base_export.h>
+
+#include <chrono>
+#include <string>
+
+namespace score
+{
+/**
+ * @brief Records how long each step of the application startup takes.
+ *
+ * Enabled by setting the SCORE_STARTUP_TRACE environment variable to the path
+ * of a file: once startup is complete, the steps are written there in the
+ * Chrome trace event format (chrome://tracing, ui.perfetto.dev), and the
+ * slowest ones are printed.
+ *
+ * @code
+ * {
+ *   score::StartupTrace::Scope _{"Load plug-ins"};
+ *   ...
+ * }
+ * @endcode
+ */
+class SCORE_LIB_BASE_EXPORT StartupTrace
+{
+public:
+  static bool enabled() noexcept;
+
+  static void record(
+      std::string name, const char* category,
+      std::chrono::steady_clock::time_point begin,
+      std::chrono::steady_clock::time_point end);
+
+  //! Writes the trace: steps recorded afterwards are ignored
+  static void finish();
+
+  struct Scope
+  {
+    explicit Scope(std::string name, const char* category = "startup")
+        : name{std::move(name)}
+        , category{category}
+    {
+      if(enabled())
+        begin = std::chrono::steady_clock::now();
+    }
+
+    ~Scope()
+    {
+      if(enabled())
+        record(std::move(name), category, begin, std::chrono::steady_clock::now());
+    }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+    std::string name;
+    const char* category{};
+    std::chrono::steady_clock::time_point begin{};
+  };
+};
+}
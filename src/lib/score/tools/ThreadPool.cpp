@@ -1,6 +1,7 @@
 #include <score/application/ApplicationServices.hpp>
 #include <score/tools/ThreadPool.hpp>
 
+#include <algorithm>
 #include <thread>
 #if __has_include(<sys/resource.h>)
 #include <sys/resource.h>
@@ -89,33 +90,121 @@ void ThreadPool::releaseThread()
 
 TaskPool::TaskPool()
 {
+  // Leave room for the GUI and the audio threads
+  int n = std::thread::hardware_concurrency();
+  n = std::clamp(n - 2, 2, 16);
+
   m_running = true;
-  int i = 0;
-  for(auto& t : m_threads)
+  m_threads.reserve(n);
+  for(int i = 0; i < n; i++)
   {
-    t = std::thread{[this, i = i++] {
+    m_threads.emplace_back([this, i] {
       ossia::set_thread_name("ossia task " + std::to_string(i));
-      while(m_running)
-      {
-        task t{};
-        if(m_queue.wait_dequeue_timed(t, 100000))
-        {
-          t();
-        }
-      }
-    }};
+      run();
+    });
   }
 }
 
 TaskPool::~TaskPool()
 {
   m_running = false;
+  m_pending.signal(m_threads.size());
   for(auto& t : m_threads)
   {
     t.join();
   }
 }
 
+void TaskPool::enqueue(entry&& e, Priority p)
+{
+  m_queues[static_cast<int>(p)].enqueue(std::move(e));
+  m_pending.signal();
+}
+
+void TaskPool::enqueue(Producer& prod, entry&& e, Priority p)
+{
+  const int q = static_cast<int>(p);
+  m_queues[q].enqueue(prod.m_tokens[q], std::move(e));
+  m_pending.signal();
+}
+
+TaskPool::Producer::Producer(TaskPool& pool)
+    : m_pool{pool}
+    , m_tokens{
+          {moodycamel::ProducerToken{pool.m_queues[0]},
+           moodycamel::ProducerToken{pool.m_queues[1]},
+           moodycamel::ProducerToken{pool.m_queues[2]}}}
+{
+}
+
+struct TaskPool::Strand::state
+{
+  explicit state(TaskPool& pool)
+      : producer{pool}
+  {
+  }
+
+  moodycamel::ConcurrentQueue<entry> queue;
+  moodycamel::ProducerToken token{queue};
+  Producer producer;
+
+  // Number of tasks posted and not finished yet
+  std::atomic_int count{};
+};
+
+TaskPool::Strand::Strand(TaskPool& pool)
+    : m_state{std::make_shared<state>(pool)}
+{
+}
+
+void TaskPool::Strand::push(entry&& e, Priority p)
+{
+  auto& s = *m_state;
+  s.queue.enqueue(s.token, std::move(e));
+
+  // A single drainer at a time: it is started when the strand was idle, and
+  // stops once it has run every task posted before it finishes.
+  if(s.count.fetch_add(1, std::memory_order_acq_rel) > 0)
+    return;
+
+  s.producer.post([state = m_state] {
+    do
+    {
+      // The task is enqueued before being counted
+      entry e;
+      while(!state->queue.try_dequeue(e))
+        ;
+
+      if(!e.cancelled || !e.cancelled->load(std::memory_order_acquire))
+        e.func();
+    } while(state->count.fetch_sub(1, std::memory_order_acq_rel) > 1);
+  }, p);
+}
+
+void TaskPool::run()
+{
+  for(;;)
+  {
+    entry e;
+    // One signal per task: once woken up a task is guaranteed to be available
+    m_pending.wait();
+    if(!m_running)
+      return;
+
+    for(bool found = false; !found;)
+    {
+      for(auto& q : m_queues)
+      {
+        if((found = q.try_dequeue(e)))
+          break;
+      }
+    }
+
+    if(!e.cancelled || !e.cancelled->load(std::memory_order_acquire))
+      e.func();
+  }
+}
+
 TaskPool& TaskPool::instance()
 {
   static std::once_flag init{};
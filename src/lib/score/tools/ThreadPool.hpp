@@ -6,8 +6,13 @@
 #include <score_lib_base_export.h>
 #include <smallfun.hpp>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <memory>
 #include <thread>
+#include <type_traits>
+#include <vector>
 namespace score
 {
 class SCORE_LIB_BASE_EXPORT ThreadPool
@@ -29,17 +34,113 @@ private:
   int m_inFlight = 0;
 };
 
+/**
+ * @brief Runs short-lived tasks on a set of threads sized to the machine.
+ *
+ * Higher priority tasks are started first. Several tasks can run at the same
+ * time: tasks which must not run concurrently or which depend on their order
+ * of submission go through a Strand.
+ */
 class SCORE_LIB_BASE_EXPORT TaskPool
 {
+  struct entry;
+
 public:
+  enum class Priority : uint8_t
+  {
+    High, //!< e.g. results awaited by the execution
+    Normal,
+    Low, //!< e.g. scans, thumbnails, caches
+  };
+  static constexpr int priorities = 3;
+
+  //! Tasks posted with a token are skipped if it is cancelled before they start
+  class CancellationToken
+  {
+  public:
+    CancellationToken()
+        : m_cancelled{std::make_shared<std::atomic_bool>(false)}
+    {
+    }
+
+    void cancel() const noexcept { m_cancelled->store(true, std::memory_order_release); }
+    bool cancelled() const noexcept
+    {
+      return m_cancelled->load(std::memory_order_acquire);
+    }
+
+  private:
+    friend class TaskPool;
+    std::shared_ptr<std::atomic_bool> m_cancelled;
+  };
+
+  /**
+   * @brief Posts tasks without allocating once its queues are warm.
+   *
+   * Lets e.g. the audio thread post tasks. It is created beforehand on another
+   * thread and used by a single thread at a time.
+   */
+  class SCORE_LIB_BASE_EXPORT Producer
+  {
+  public:
+    explicit Producer(TaskPool& pool);
+
+    template <typename F>
+    void post(F&& func, Priority p = Priority::Normal)
+    {
+      m_pool.enqueue(*this, entry{task(std::forward<F>(func)), {}}, p);
+    }
+
+  private:
+    friend class TaskPool;
+    TaskPool& m_pool;
+    std::array<moodycamel::ProducerToken, priorities> m_tokens;
+  };
+
+  /**
+   * @brief Runs the tasks posted to it one after the other, in order.
+   *
+   * For clients whose requests depend on each other, e.g. plug-in workers.
+   * Like Producer, it is used by a single thread at a time and does not
+   * allocate once warm.
+   */
+  class SCORE_LIB_BASE_EXPORT Strand
+  {
+  public:
+    explicit Strand(TaskPool& pool);
+
+    template <typename F>
+    void post(F&& func, Priority p = Priority::Normal)
+    {
+      push(entry{task(std::forward<F>(func)), {}}, p);
+    }
+
+    template <typename F>
+    void post(const CancellationToken& token, F&& func, Priority p = Priority::Normal)
+    {
+      push(entry{task(std::forward<F>(func)), token.m_cancelled}, p);
+    }
+
+  private:
+    struct state;
+    void push(entry&& e, Priority p);
+    std::shared_ptr<state> m_state;
+  };
+
   TaskPool();
   ~TaskPool();
   static TaskPool& instance();
 
   template <typename F>
-  void post(F&& func)
+  void post(F&& func, Priority p = Priority::Normal)
+  {
+    enqueue(entry{task(std::forward<F>(func)), {}}, p);
+  }
+
+  template <typename F>
+  void post(const CancellationToken& token, F&& func, Priority p = Priority::Normal)
   {
-    m_queue.enqueue(std::forward<F>(func));
+    enqueue(entry{task(std::forward<F>(func)), token.m_cancelled}, p);
   }
 
 private:
@@ -52,8 +153,68 @@ private:
 #endif
       std::max((int)8, (int)std::max(alignof(std::function<void()>), alignof(double))),
       smallfun::Methods::Move>;
-  moodycamel::BlockingConcurrentQueue<task> m_queue;
-  std::array<std::thread, 1> m_threads;
+
+  struct entry
+  {
+    task func;
+    std::shared_ptr<std::atomic_bool> cancelled;
+  };
+
+  void enqueue(entry&& e, Priority p);
+  void enqueue(Producer& prod, entry&& e, Priority p);
+  void run();
+
+  std::array<moodycamel::ConcurrentQueue<entry>, priorities> m_queues;
+  moodycamel::LightweightSemaphore m_pending;
+  std::vector<std::thread> m_threads;
   std::atomic_bool m_running{};
 };
+
+/**
+ * @brief Calls func(i) for i in [0, n), helped by the task pool.
+ *
+ * The calling thread takes part in the work and returns as soon as every call
+ * has finished: helpers which only start afterwards, e.g. because they were
+ * queued behind long tasks, have nothing left to do and are not waited for.
+ * func must not throw.
+ */
+template <typename F>
+void parallel_for(int n, F&& func, TaskPool::Priority p = TaskPool::Priority::Normal)
+{
+  if(n <= 0)
+    return;
+
+  // Outlives the call for the helpers which start late
+  struct state
+  {
+    std::remove_reference_t<F>* func{};
+    int count{};
+    std::atomic_int next{};
+    std::atomic_int done{};
+
+    void work()
+    {
+      for(int i = next++; i < count; i = next++)
+      {
+        (*func)(i);
+        if(++done == count)
+          done.notify_one();
+      }
+    }
+  };
+
+  auto s = std::make_shared<state>();
+  s->func = &func;
+  s->count = n;
+
+  const int helpers = std::min(n - 1, int(std::thread::hardware_concurrency()) - 1);
+  auto& pool = TaskPool::instance();
+  for(int i = 0; i < helpers; i++)
+    pool.post([s] { s->work(); }, p);
+
+  s->work();
+
+  for(int d = s->done.load(); d < n; d = s->done.load())
+    s->done.wait(d);
+}
 }
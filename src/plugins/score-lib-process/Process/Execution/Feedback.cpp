@@ -0,0 +1,45 @@
+#include "Feedback.hpp"
+
+#include <ossia/detail/algorithms.hpp>
+
+namespace Execution
+{
+FeedbackTable::FeedbackTable()
+{
+  m_slots.reserve(256);
+}
+
+FeedbackTable::~FeedbackTable() = default;
+
+std::shared_ptr<FeedbackTable::Slot> FeedbackTable::add(Callback apply)
+{
+  auto slot = std::make_shared<Slot>();
+  slot->m_apply = std::move(apply);
+  m_slots.push_back(slot);
+  return slot;
+}
+
+void FeedbackTable::remove(const std::shared_ptr<Slot>& slot)
+{
+  // The execution thread may still write to it until its callback is removed
+  slot->m_apply = {};
+  ossia::remove_erase(m_slots, slot);
+}
+
+void FeedbackTable::flush()
+{
+  // Callbacks may remove slots: a slot shifted this way is only applied
+  // at the next flush since its dirty flag stays set.
+  for(std::size_t i = 0; i < m_slots.size(); i++)
+  {
+    auto slot = m_slots[i];
+    if(!slot->m_dirty.exchange(false, std::memory_order_acquire))
+      continue;
+
+    const bool running = slot->m_running.load(std::memory_order_relaxed);
+    const ossia::time_value date{slot->m_date.load(std::memory_order_relaxed)};
+    if(slot->m_apply)
+      slot->m_apply(running, date);
+  }
+}
+}
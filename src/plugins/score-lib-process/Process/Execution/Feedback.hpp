@@ -0,0 +1,63 @@
+#pragma once
+#include <ossia/editor/scenario/time_value.hpp>
+
+#include <score_lib_process_export.h>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace Execution
+{
+/**
+ * @brief Latest state of the executing elements, for display.
+ *
+ * The execution thread writes the state of an element in its slot as often
+ * as it changes, without locking nor allocating. The GUI thread applies the
+ * slots which changed at its own refresh rate: intermediate states are
+ * coalesced, so the cost of the feedback depends on the number of elements
+ * and not on the number of ticks.
+ */
+class SCORE_LIB_PROCESS_EXPORT FeedbackTable
+{
+public:
+  using Callback = std::function<void(bool running, ossia::time_value date)>;
+
+  class Slot
+  {
+  public:
+    //! To be called from the execution thread
+    void write(bool running, ossia::time_value date) noexcept
+    {
+      m_date.store(date.impl, std::memory_order_relaxed);
+      m_running.store(running, std::memory_order_relaxed);
+      m_dirty.store(true, std::memory_order_release);
+    }
+
+  private:
+    friend class FeedbackTable;
+    std::atomic<int64_t> m_date{};
+    std::atomic_bool m_running{};
+    std::atomic_bool m_dirty{};
+
+    // Only accessed from the GUI thread
+    Callback m_apply;
+  };
+
+  FeedbackTable();
+  FeedbackTable(const FeedbackTable&) = delete;
+  FeedbackTable& operator=(const FeedbackTable&) = delete;
+  ~FeedbackTable();
+
+  //! The returned slot is meant to be captured by the execution callbacks
+  std::shared_ptr<Slot> add(Callback apply);
+  void remove(const std::shared_ptr<Slot>& slot);
+
+  //! Calls the callbacks of the slots written since the last flush
+  void flush();
+
+private:
+  std::vector<std::shared_ptr<Slot>> m_slots;
+};
+}
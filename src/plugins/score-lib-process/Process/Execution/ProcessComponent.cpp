@@ -5,6 +5,10 @@
 #include <Process/ExecutionContext.hpp>
 #include <Process/ExecutionSetup.hpp>
 
+#include <score/tools/ThreadPool.hpp>
+
+#include <QDebug>
+
 #include <wobjectimpl.h>
 W_OBJECT_IMPL(Execution::ProcessComponent)
 
@@ -16,6 +20,47 @@ ProcessComponentFactoryList::~ProcessComponentFactoryList() = default;
 
 void ProcessComponent::lazy_init() { }
 
+void ProcessComponentFactory::prepare(
+    Process::ProcessModel& proc, const Context& ctx) const
+{
+}
+
+void ProcessComponentFactoryList::prepare(
+    const std::vector<Process::ProcessModel*>& procs, const Context& ctx) const
+{
+  struct Job
+  {
+    const ProcessComponentFactory* factory{};
+    Process::ProcessModel* process{};
+  };
+  std::vector<Job> jobs;
+  jobs.reserve(procs.size());
+  for(auto proc : procs)
+  {
+    if(auto fac = factory(*proc))
+      jobs.push_back({fac, proc});
+  }
+
+  const int n = std::ssize(jobs);
+  if(n == 0)
+    return;
+
+  // Playback waits for it
+  score::parallel_for(n, [&jobs, &ctx](int i) {
+    try
+    {
+      jobs[i].factory->prepare(*jobs[i].process, ctx);
+    }
+    catch(const std::exception& e)
+    {
+      qDebug() << "Error during plug-in preparation: " << e.what();
+    }
+    catch(...)
+    {
+    }
+  }, score::TaskPool::Priority::High);
+}
+
 ProcessComponent::ProcessComponent(
     Process::ProcessModel& proc, const Context& ctx, const QString& name,
     QObject* parent)
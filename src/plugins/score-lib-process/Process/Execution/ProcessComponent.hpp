@@ -16,6 +16,7 @@
 #include <score_lib_process_export.h>
 
 #include <memory>
+#include <vector>
 #include <verdigris>
 
 #if __cpp_lib_concepts >= 202002L
@@ -105,6 +106,11 @@ public:
   virtual ~ProcessComponentFactory() override;
   virtual std::shared_ptr<ProcessComponent>
   make(Process::ProcessModel& proc, const Context& ctx, QObject* parent) const = 0;
+
+  //! Reimplement this to do the expensive part of the component creation
+  //! ahead of make(). It is called concurrently from worker threads before
+  //! execution starts: it must not create QObjects nor touch the graph.
+  virtual void prepare(Process::ProcessModel& proc, const Context& ctx) const;
 };
 
 template <typename ProcessComponent_T>
@@ -154,6 +160,10 @@ class SCORE_LIB_PROCESS_EXPORT ProcessComponentFactoryList final
 {
 public:
   ~ProcessComponentFactoryList();
+
+  //! Calls ProcessComponentFactory::prepare for all the processes, in parallel.
+  void
+  prepare(const std::vector<Process::ProcessModel*>& procs, const Context& ctx) const;
 };
 }
 
@@ -53,6 +53,7 @@ class ProcessModel;
 }
 namespace Execution
 {
+class FeedbackTable;
 class ProcessComponent;
 class ProcessComponentFactory;
 class ProcessComponentFactoryList;
@@ -67,6 +68,7 @@ using reverse_time_function = smallfun::function<TimeVal(const ossia::time_value
 
 using ExecutionCommandQueue = ossia::spsc_queue<ExecutionCommand, 1024>;
 using EditionCommandQueue = moodycamel::ConcurrentQueue<ExecutionCommand>;
+using WorkerCommandQueue = moodycamel::ConcurrentQueue<ExecutionCommand>;
 using GCCommandQueue = moodycamel::ConcurrentQueue<GCCommand>;
 
 //! Useful structures when creating the execution elements.
@@ -89,7 +91,13 @@ struct SCORE_LIB_PROCESS_EXPORT Context
   //! \see LiveModification
   ExecutionCommandQueue& executionQueue;
   EditionCommandQueue& editionQueue;
+
+  //! Like executionQueue, but can be fed from any thread, e.g. by worker tasks
+  WorkerCommandQueue& workerQueue;
   GCCommandQueue& gcQueue;
+
+  //! Latest state of the executing elements, applied by the GUI at its own pace
+  FeedbackTable& feedback;
   SetupContext& setup;
 
   const std::shared_ptr<ossia::graph_interface>& execGraph;
@@ -8,6 +8,7 @@
 #include <Crousti/CpuAnalysisNode.hpp>
 #include <Crousti/CpuFilterNode.hpp>
 #include <Crousti/CpuGeneratorNode.hpp>
+#include <Crousti/FileCache.hpp>
 #include <Crousti/GpuComputeNode.hpp>
 #include <Crousti/GpuNode.hpp>
 #include <Crousti/MessageBus.hpp>
@@ -21,7 +22,6 @@
 #include <ossia/dataflow/node_process.hpp>
 #include <ossia/network/context.hpp>
 
-#include <ossia-qt/invoke.hpp>
 
 #include <QGuiApplication>
 
@@ -30,8 +30,6 @@
 #include <Gfx/GfxApplicationPlugin.hpp>
 #endif
 
-#include <Media/AudioDecoder.hpp>
-
 #include <score/tools/ThreadPool.hpp>
 
 #include <QTimer>
@@ -58,82 +56,31 @@ filenameFromPort(const ossia::value& value, const score::DocumentContext& ctx)
   return {};
 }
 
-// TODO refactor this into a generic explicit soundfile loaded mechanism
 [[nodiscard]] static auto
 loadSoundfile(const ossia::value& value, const score::DocumentContext& ctx, double rate)
 {
   // Initialize the control with the current soundfile
   if(auto str = filenameFromPort(value, ctx); !str.isEmpty())
-  {
-    auto dec = Media::AudioDecoder::decode_synchronous(str, rate);
-
-    if(dec.has_value())
-    {
-      auto hdl = std::make_shared<ossia::audio_data>();
-      hdl->data = std::move(dec->second);
-      hdl->path = str.toStdString();
-      hdl->rate = rate;
-      return hdl;
-    }
-  }
+    return FileCache::instance().loadSoundfile(str, rate);
   return ossia::audio_handle{};
 }
 
-using midifile_handle = std::shared_ptr<oscr::midifile_data>;
 [[nodiscard]] inline midifile_handle
 loadMidifile(const ossia::value& value, const score::DocumentContext& ctx)
 {
-  // Initialize the control with the current soundfile
   if(auto str = filenameFromPort(value, ctx); !str.isEmpty())
-  {
-    QFile f(str);
-    if(!f.open(QIODevice::ReadOnly))
-      return {};
-    auto ptr = f.map(0, f.size());
-
-    auto hdl = std::make_shared<oscr::midifile_data>();
-    if(auto ret = hdl->reader.parse((uint8_t*)ptr, f.size());
-       ret == libremidi::reader::invalid)
-      return {};
-
-    hdl->filename = str.toStdString();
-    return hdl;
-  }
+    return FileCache::instance().loadMidifile(str);
   return {};
 }
 
-using raw_file_handle = std::shared_ptr<raw_file_data>;
 [[nodiscard]] inline raw_file_handle loadRawfile(
     const ossia::value& value, const score::DocumentContext& ctx, bool text, bool mmap)
 {
-  // Initialize the control with the current soundfile
   if(auto filename = filenameFromPort(value, ctx); !filename.isEmpty())
-  {
-    if(!QFile::exists(filename))
-      return {};
-
-    auto hdl = std::make_shared<oscr::raw_file_data>();
-    hdl->file.setFileName(filename);
-    if(!hdl->file.open(QIODevice::ReadOnly))
-      return {};
-
-    if(mmap)
-    {
-      auto map = (char*)hdl->file.map(0, hdl->file.size());
-      hdl->data = QByteArray::fromRawData(map, hdl->file.size());
-    }
-    else
-    {
-      if(text)
-        hdl->file.setTextModeEnabled(true);
-
-      hdl->data = hdl->file.readAll();
-    }
-    hdl->filename = filename.toStdString();
-    return hdl;
-  }
+    return FileCache::instance().loadRawfile(filename, text, mmap);
   return {};
 }
+
 [[nodiscard]] inline auto loadSoundfile(
     const ossia::value& value, const score::DocumentContext& ctx,
     const std::shared_ptr<ossia::execution_state>& st)
@@ -168,6 +115,37 @@ struct setup_Impl0
   const std::shared_ptr<ExecNode>& node_ptr;
   QObject* parent;
 
+  // Files changed during execution are loaded on the task pool and sent from
+  // there to the execution thread: only the latest request of a port is applied.
+  struct file_request
+  {
+    std::weak_ptr<Execution::WorkerCommandQueue> queue;
+    std::shared_ptr<std::atomic_int> latest = std::make_shared<std::atomic_int>(0);
+
+    int next() const noexcept { return ++*latest; }
+
+    template <typename F>
+    void apply(int request, F&& f) const
+    {
+      if(request != latest->load())
+        return;
+
+      // Commands enqueued from different threads may run in any order:
+      // the request is checked again where it is applied
+      if(auto q = queue.lock())
+        q->enqueue([latest = latest, request, f = std::forward<F>(f)]() mutable {
+          if(request == latest->load())
+            f();
+        });
+    }
+  };
+
+  file_request make_file_request() const
+  {
+    return {std::shared_ptr<Execution::WorkerCommandQueue>(
+        ctx.alias.lock(), &ctx.workerQueue)};
+  }
+
   template <typename Field, std::size_t NPred, std::size_t NField>
   struct con_unvalidated
   {
@@ -234,26 +212,30 @@ struct setup_Impl0
 
     // Connect to changes
     std::weak_ptr<ExecNode> weak_node = node_ptr;
-    std::weak_ptr<ossia::execution_state> weak_st = ctx.execState;
     QObject::connect(
         inlet, &Process::ControlInlet::valueChanged, parent,
         [&ctx = this->ctx, weak_node = std::move(weak_node),
-         weak_st = std::move(weak_st)](const ossia::value& v) {
-      if(auto n = weak_node.lock())
-        if(auto st = weak_st.lock())
-          if(auto file = loadSoundfile(v, ctx.doc, st))
-          {
-            ctx.executionQueue.enqueue([f = std::move(file), weak_node]() mutable {
-              auto n = weak_node.lock();
-              if(!n)
-                return;
-
-              // We store the sound file handle returned in this lambda so that it gets
-              // GC'd in the main thread
-              n->soundfile_loaded(
-                  f, avnd::predicate_index<N>{}, avnd::field_index<NField>{});
-            });
-          }
+         req = make_file_request()](const ossia::value& v) {
+      auto path = filenameFromPort(v, ctx.doc);
+      if(path.isEmpty() || weak_node.expired())
+        return;
+
+      const double rate = ossia::exec_state_facade{ctx.execState.get()}.sampleRate();
+      FileCache::instance().loadSoundfileAsync(
+          path, rate, [weak_node, req, id = req.next()](ossia::audio_handle file) {
+        if(!file)
+          return;
+        req.apply(id, [f = std::move(file), weak_node]() mutable {
+          auto n = weak_node.lock();
+          if(!n)
+            return;
+
+          // We store the sound file handle returned in this lambda so that it gets
+          // GC'd in the main thread
+          n->soundfile_loaded(
+              f, avnd::predicate_index<N>{}, avnd::field_index<NField>{});
+        });
+      });
     });
   }
 
@@ -270,25 +252,29 @@ struct setup_Impl0
 
     // Connect to changes
     std::weak_ptr<ExecNode> weak_node = node_ptr;
-    std::weak_ptr<ossia::execution_state> weak_st = ctx.execState;
     QObject::connect(
         inlet, &Process::ControlInlet::valueChanged, parent,
-        [inlet, &ctx = this->ctx,
-         weak_node = std::move(weak_node)](const ossia::value& v) {
-      if(auto n = weak_node.lock())
-        if(auto file = loadMidifile(v, ctx.doc))
-        {
-          ctx.executionQueue.enqueue([f = std::move(file), weak_node]() mutable {
-            auto n = weak_node.lock();
-            if(!n)
-              return;
-
-            // We store the sound file handle returned in this lambda so that it gets
-            // GC'd in the main thread
-            n->midifile_loaded(
-                f, avnd::predicate_index<N>{}, avnd::field_index<NField>{});
-          });
-        }
+        [&ctx = this->ctx, weak_node = std::move(weak_node),
+         req = make_file_request()](const ossia::value& v) {
+      auto path = filenameFromPort(v, ctx.doc);
+      if(path.isEmpty() || weak_node.expired())
+        return;
+
+      FileCache::instance().loadMidifileAsync(
+          path, [weak_node, req, id = req.next()](midifile_handle file) {
+        if(!file)
+          return;
+        req.apply(id, [f = std::move(file), weak_node]() mutable {
+          auto n = weak_node.lock();
+          if(!n)
+            return;
+
+          // We store the sound file handle returned in this lambda so that it gets
+          // GC'd in the main thread
+          n->midifile_loaded(
+              f, avnd::predicate_index<N>{}, avnd::field_index<NField>{});
+        });
+      });
     });
   }
 
@@ -334,43 +320,50 @@ struct setup_Impl0
 
     // Connect to changes
     std::weak_ptr<ExecNode> weak_node = node_ptr;
-    std::weak_ptr<ossia::execution_state> weak_st = ctx.execState;
     QObject::connect(
         inlet, &Process::ControlInlet::valueChanged, parent,
-        [inlet, &ctx = this->ctx, weak_node = std::move(weak_node)] {
-      if(auto n = weak_node.lock())
-        if(auto file = loadRawfile(inlet->value(), ctx.doc, has_text, has_mmap))
+        [inlet, &ctx = this->ctx, weak_node = std::move(weak_node),
+         req = make_file_request()] {
+      auto path = filenameFromPort(inlet->value(), ctx.doc);
+      if(path.isEmpty() || weak_node.expired())
+        return;
+
+      FileCache::instance().loadRawfileAsync(
+          path, has_text, has_mmap,
+          [weak_node, req, id = req.next()](raw_file_handle file) {
+        if(!file)
+          return;
+        if constexpr(avnd::port_can_process<Field>)
         {
-          if constexpr(avnd::port_can_process<Field>)
-          {
-            auto func = executePortPreprocess<Field>(*file);
-            ctx.executionQueue.enqueue(
-                [f = std::move(file), weak_node, ff = std::move(func)]() mutable {
-              auto n = weak_node.lock();
-              if(!n)
-                return;
+          // The pre-processing runs here in the task pool as well
+          auto func = executePortPreprocess<Field>(*file);
+          req.apply(
+              id, [f = std::move(file), weak_node, ff = std::move(func)]() mutable {
+            auto n = weak_node.lock();
+            if(!n)
+              return;
 
-              // We store the sound file handle returned in this lambda so that it gets
-              // GC'd in the main thread
-              n->file_loaded(f, avnd::predicate_index<N>{}, avnd::field_index<NField>{});
-              if(ff)
-                ff(n->impl.effect);
-            });
-          }
-          else
-          {
-            ctx.executionQueue.enqueue([f = std::move(file), weak_node]() mutable {
-              auto n = weak_node.lock();
-              if(!n)
-                return;
+            // We store the sound file handle returned in this lambda so that it gets
+            // GC'd in the main thread
+            n->file_loaded(f, avnd::predicate_index<N>{}, avnd::field_index<NField>{});
+            if(ff)
+              ff(n->impl.effect);
+          });
+        }
+        else
+        {
+          req.apply(id, [f = std::move(file), weak_node]() mutable {
+            auto n = weak_node.lock();
+            if(!n)
+              return;
 
-              // We store the sound file handle returned in this lambda so that it gets
-              // GC'd in the main thread
-              n->file_loaded(f, avnd::predicate_index<N>{}, avnd::field_index<NField>{});
-            });
-          }
+            // We store the sound file handle returned in this lambda so that it gets
+            // GC'd in the main thread
+            n->file_loaded(f, avnd::predicate_index<N>{}, avnd::field_index<NField>{});
+          });
         }
-        });
+      });
+    });
   }
 };
 
@@ -559,6 +552,42 @@ public:
   }
 
   [[no_unique_address]] type_if<int, is_gpu<Node>> node_id = -1;
+  score::TaskPool::CancellationToken m_workerTasks;
+
+  // Requests of a same node run in order on a strand. The worker queue is only
+  // FIFO per producer: the strand sends the results through its own token so
+  // that they are applied in the order of the requests.
+  struct strand_output
+  {
+    explicit strand_output(std::shared_ptr<Execution::WorkerCommandQueue> q)
+        : queue{std::move(q)}
+        , token{*queue}
+    {
+    }
+
+    template <typename F>
+    void enqueue(F&& f)
+    {
+      queue->enqueue(token, std::forward<F>(f));
+    }
+
+    std::shared_ptr<Execution::WorkerCommandQueue> queue;
+    moodycamel::ProducerToken token;
+  };
+
+  score::TaskPool::Strand m_workerStrand{score::TaskPool::instance()};
+  std::shared_ptr<strand_output> m_workerOutput;
+  score::TaskPool::Strand m_soundfileStrand{score::TaskPool::instance()};
+  std::shared_ptr<strand_output> m_soundfileOutput;
+
+  std::shared_ptr<strand_output> make_output(const ::Execution::Context& ctx)
+  {
+    auto alias = ctx.alias.lock();
+    if(!alias)
+      return {};
+    return std::make_shared<strand_output>(
+        std::shared_ptr<Execution::WorkerCommandQueue>(alias, &ctx.workerQueue));
+  }
 
   Executor(ProcessModel<Node>& element, const ::Execution::Context& ctx, QObject* p)
       : Execution::ProcessComponent_T<ProcessModel<Node>, ossia::node_process>{
@@ -730,17 +759,22 @@ public:
       soundfile_inputs_type::for_all_n2(
           avnd::get_inputs<Node>(eff), setup_Impl0<Node>{element, ctx, ptr, this});
 
-      auto& tq = score::TaskPool::instance();
+      m_soundfileOutput = make_output(ctx);
       node.soundfiles.load_request
-          = [&tq, p = std::weak_ptr{ptr}, &ctx](std::string& str, int idx) {
+          = [strand = m_soundfileStrand, output = std::weak_ptr{m_soundfileOutput},
+             p = std::weak_ptr{ptr}, &ctx](std::string& str, int idx) mutable {
         auto eff_ptr = p.lock();
         if(!eff_ptr)
           return;
-        tq.post([eff_ptr = std::move(eff_ptr), filename = str, &ctx, idx]() mutable {
+        strand.post([eff_ptr = std::move(eff_ptr), output, filename = str, &ctx,
+                     idx]() mutable {
+          auto out = output.lock();
+          if(!out)
+            return;
           if(auto file = loadSoundfile(filename, ctx.doc, ctx.execState))
           {
-            ctx.executionQueue.enqueue(
-                [sf = std::move(file), p = std::weak_ptr{eff_ptr}, idx]() mutable {
+            out->enqueue([sf = std::move(file), p = std::weak_ptr{eff_ptr},
+                          idx]() mutable {
               auto eff_ptr = p.lock();
               if(!eff_ptr)
                 return;
@@ -755,7 +789,7 @@ public:
               });
             });
           }
-        });
+        }, score::TaskPool::Priority::High);
       };
     }
     if constexpr(midifile_inputs_type::size > 0)
@@ -829,22 +863,22 @@ public:
   {
     if constexpr(avnd::has_worker<Node>)
     {
-      // Initialize the thread pool beforehand
-      auto& tq = score::TaskPool::instance();
       using worker_type = decltype(eff.effect.worker);
+      if(!m_workerOutput)
+        m_workerOutput = make_output(ctx);
+
       for(auto& eff : eff.effects())
       {
         std::weak_ptr eff_ptr = std::shared_ptr<Node>(this->node, &eff);
-        std::weak_ptr qex_ptr = std::shared_ptr<Execution::ExecutionCommandQueue>(
-            ctx.alias.lock(), &ctx.executionQueue);
 
         eff.worker.request
-            = [&tq, qex_ptr = std::move(qex_ptr),
-               eff_ptr = std::move(eff_ptr)]<typename... Args>(Args&&... f) {
+            = [strand = m_workerStrand, output = std::weak_ptr{m_workerOutput},
+               eff_ptr = std::move(eff_ptr),
+               token = m_workerTasks]<typename... Args>(Args&&... f) mutable {
           // request() is invoked in the DSP / processor thread
           // and just posts the task to the thread pool
-          tq.post([eff_ptr = std::move(eff_ptr), qex_ptr = std::move(qex_ptr),
-                   ... ff = std::forward<Args>(f)]() mutable {
+          strand.post(token, [eff_ptr = eff_ptr, output = output,
+                              ... ff = std::forward<Args>(f)]() mutable {
             // This happens in the worker thread
             // If for some reason the object has already been removed, not much
             // reason to perform the work
@@ -865,27 +899,20 @@ public:
               if(!res)
                 return;
 
-              // Execution queue is currently spsc from main thread to an exec thread,
-              // we cannot just yeet the result back from the thread-pool
-              ossia::qt::run_async(
-                  qApp, [eff_ptr = std::move(eff_ptr), qex_ptr = std::move(qex_ptr),
-                         res = std::move(res)]() mutable {
-                    // Main thread
-                    std::shared_ptr qex = qex_ptr.lock();
-                    if(!qex)
-                      return;
-
-                    qex->enqueue(
-                        [eff_ptr = std::move(eff_ptr), res = std::move(res)]() mutable {
-                  // DSP / processor thread
-                  // We need res to be mutable so that the worker can use it to e.g. store
-                  // old data which will be freed back in the main thread
-                  if(auto p = eff_ptr.lock())
-                    res(*p);
-                    });
-                  });
+              // The result goes straight to the DSP thread
+              auto out = output.lock();
+              if(!out)
+                return;
+
+              out->enqueue(
+                  [eff_ptr = std::move(eff_ptr), res = std::move(res)]() mutable {
+                // We need res to be mutable so that the worker can use it to e.g. store
+                // old data which will be freed back in the main thread
+                if(auto p = eff_ptr.lock())
+                  res(*p);
+              });
             }
-          });
+          }, score::TaskPool::Priority::High);
         };
       }
     }
@@ -906,6 +933,9 @@ public:
 
   void cleanup() override
   {
+    // Requests which have not started yet are not needed anymore
+    m_workerTasks.cancel();
+
     if constexpr(requires { this->process().from_ui; })
     {
       this->process().from_ui = [](QByteArray arr) {};
@@ -0,0 +1,186 @@
+#include "FileCache.hpp"
+
+#include <Media/AudioDecoder.hpp>
+
+#include <score/tools/ThreadPool.hpp>
+
+#include <ossia/detail/algorithms.hpp>
+
+#include <QDebug>
+#include <QFile>
+#include <QFileInfo>
+
+#include <avnd/binding/ossia/node.hpp>
+#include <libremidi/reader.hpp>
+
+namespace oscr
+{
+namespace
+{
+enum RawFileOptions
+{
+  Text = 1,
+  MMap = 2
+};
+
+static qint64 lastModified(const QString& path)
+{
+  return QFileInfo{path}.lastModified().toMSecsSinceEpoch();
+}
+
+static ossia::audio_handle decodeSoundfile(const QString& path, double rate)
+{
+  auto dec = Media::AudioDecoder::decode_synchronous(path, rate);
+  if(!dec.has_value())
+    return {};
+
+  auto hdl = std::make_shared<ossia::audio_data>();
+  hdl->data = std::move(dec->second);
+  hdl->path = path.toStdString();
+  hdl->rate = rate;
+  return hdl;
+}
+
+static midifile_handle parseMidifile(const QString& path)
+{
+  QFile f(path);
+  if(!f.open(QIODevice::ReadOnly))
+    return {};
+  auto ptr = f.map(0, f.size());
+
+  auto hdl = std::make_shared<oscr::midifile_data>();
+  if(auto ret = hdl->reader.parse((uint8_t*)ptr, f.size());
+     ret == libremidi::reader::invalid)
+    return {};
+
+  hdl->filename = path.toStdString();
+  return hdl;
+}
+
+static raw_file_handle readRawfile(const QString& path, bool text, bool mmap)
+{
+  if(!QFile::exists(path))
+    return {};
+
+  auto hdl = std::make_shared<oscr::raw_file_data>();
+  hdl->file.setFileName(path);
+  if(!hdl->file.open(QIODevice::ReadOnly))
+    return {};
+
+  if(mmap)
+  {
+    auto map = (char*)hdl->file.map(0, hdl->file.size());
+    hdl->data = QByteArray::fromRawData(map, hdl->file.size());
+  }
+  else
+  {
+    if(text)
+      hdl->file.setTextModeEnabled(true);
+
+    hdl->data = hdl->file.readAll();
+  }
+  hdl->filename = path.toStdString();
+  return hdl;
+}
+}
+
+FileCache& FileCache::instance()
+{
+  static FileCache cache;
+  return cache;
+}
+
+template <typename T, typename F>
+std::shared_ptr<T> FileCache::get(Table<T>& table, Key key, F&& load)
+{
+  std::promise<std::shared_ptr<T>> promise;
+  {
+    std::unique_lock lck{m_mutex};
+    auto& e = table[key];
+    if(auto data = e.data.lock())
+      return data;
+
+    if(e.pending.valid())
+    {
+      // Another thread is loading this file: wait for it
+      auto pending = e.pending;
+      lck.unlock();
+      return pending.get();
+    }
+
+    e.pending = promise.get_future().share();
+  }
+
+  std::shared_ptr<T> data;
+  try
+  {
+    data = load();
+  }
+  catch(const std::exception& e)
+  {
+    qDebug() << "Could not load " << key.path << ": " << e.what();
+  }
+  catch(...)
+  {
+    qDebug() << "Could not load " << key.path;
+  }
+  promise.set_value(data);
+
+  std::lock_guard lck{m_mutex};
+  auto& e = table[key];
+  e.data = data;
+  e.pending = {};
+
+  // Forget the files which are not used anymore
+  ossia::erase_if(table, [](const auto& elt) {
+    return elt.second.data.expired() && !elt.second.pending.valid();
+  });
+  return data;
+}
+
+ossia::audio_handle FileCache::loadSoundfile(const QString& path, double rate)
+{
+  return get(m_soundfiles, Key{path, lastModified(path), rate, 0}, [&] {
+    return decodeSoundfile(path, rate);
+  });
+}
+
+midifile_handle FileCache::loadMidifile(const QString& path)
+{
+  return get(m_midifiles, Key{path, lastModified(path), 0., 0}, [&] {
+    return parseMidifile(path);
+  });
+}
+
+raw_file_handle FileCache::loadRawfile(const QString& path, bool text, bool mmap)
+{
+  const int options = (text ? Text : 0) | (mmap ? MMap : 0);
+  return get(m_rawfiles, Key{path, lastModified(path), 0., options}, [&] {
+    return readRawfile(path, text, mmap);
+  });
+}
+
+void FileCache::loadSoundfileAsync(
+    const QString& path, double rate, std::function<void(ossia::audio_handle)> f)
+{
+  score::TaskPool::instance().post([this, path, rate, f = std::move(f)] {
+    f(loadSoundfile(path, rate));
+  }, score::TaskPool::Priority::High);
+}
+
+void FileCache::loadMidifileAsync(
+    const QString& path, std::function<void(midifile_handle)> f)
+{
+  score::TaskPool::instance().post([this, path, f = std::move(f)] {
+    f(loadMidifile(path));
+  }, score::TaskPool::Priority::High);
+}
+
+void FileCache::loadRawfileAsync(
+    const QString& path, bool text, bool mmap, std::function<void(raw_file_handle)> f)
+{
+  score::TaskPool::instance().post([this, path, text, mmap, f = std::move(f)] {
+    f(loadRawfile(path, text, mmap));
+  }, score::TaskPool::Priority::High);
+}
+}
@@ -0,0 +1,83 @@
+#pragma once
+#include <ossia/dataflow/nodes/media.hpp>
+#include <ossia/detail/hash_map.hpp>
+
+#include <QHash>
+#include <QString>
+
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+
+namespace oscr
+{
+struct midifile_data;
+struct raw_file_data;
+using midifile_handle = std::shared_ptr<oscr::midifile_data>;
+using raw_file_handle = std::shared_ptr<oscr::raw_file_data>;
+
+/**
+ * @brief Process-wide cache of the files loaded by the avnd file ports.
+ *
+ * Files are keyed by path, modification date and loading options (sample
+ * rate, text / mmap mode): every instance pointing to the same file shares
+ * the same decoded data, which is freed once the last of them releases it.
+ * Concurrent requests for a file which is being loaded wait for it instead
+ * of loading it again.
+ *
+ * Thread-safe: the load* functions run in the calling thread, the
+ * load*Async functions on the task pool, calling back from there.
+ */
+class FileCache
+{
+public:
+  static FileCache& instance();
+
+  ossia::audio_handle loadSoundfile(const QString& path, double rate);
+  midifile_handle loadMidifile(const QString& path);
+  raw_file_handle loadRawfile(const QString& path, bool text, bool mmap);
+
+  void loadSoundfileAsync(
+      const QString& path, double rate, std::function<void(ossia::audio_handle)> f);
+  void loadMidifileAsync(const QString& path, std::function<void(midifile_handle)> f);
+  void loadRawfileAsync(
+      const QString& path, bool text, bool mmap, std::function<void(raw_file_handle)> f);
+
+private:
+  struct Key
+  {
+    struct hash
+    {
+      std::size_t operator()(const Key& k) const noexcept
+      {
+        return qHashMulti(0, k.path, k.modified, k.rate, k.options);
+      }
+    };
+    bool operator==(const Key& other) const noexcept = default;
+
+    QString path;
+    qint64 modified{};
+    double rate{};
+    int options{};
+  };
+
+  template <typename T>
+  struct Entry
+  {
+    std::weak_ptr<T> data;
+    std::shared_future<std::shared_ptr<T>> pending;
+  };
+
+  template <typename T>
+  using Table = ossia::hash_map<Key, Entry<T>, Key::hash>;
+
+  template <typename T, typename F>
+  std::shared_ptr<T> get(Table<T>& table, Key key, F&& load);
+
+  std::mutex m_mutex;
+  Table<ossia::audio_data> m_soundfiles;
+  Table<midifile_data> m_midifiles;
+  Table<raw_file_data> m_rawfiles;
+};
+}
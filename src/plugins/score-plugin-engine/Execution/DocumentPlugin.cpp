@@ -4,6 +4,8 @@
 
 #include "BaseScenarioComponent.hpp"
 
+#include <Process/Execution/ProcessComponent.hpp>
+
 #include <Explorer/DocumentPlugin/DeviceDocumentPlugin.hpp>
 
 #include <Scenario/Application/ScenarioActions.hpp>
@@ -40,6 +42,8 @@
 
 #include <QCoreApplication>
 
+#include <utility>
+
 #include <wobjectimpl.h>
 W_REGISTER_ARGTYPE(ossia::bench_map)
 W_OBJECT_IMPL(Execution::DocumentPlugin)
@@ -49,8 +53,8 @@ DocumentPlugin::ContextData::ContextData(const score::DocumentContext& ctx)
     : setupContext{context}
     , context
 {
-  {}, ctx, m_created, {}, {}, m_execQueue, m_editionQueue, m_gcQueue, setupContext,
-      execGraph, execState
+  {}, ctx, m_created, {}, {}, m_execQueue, m_editionQueue, m_workerQueue, m_gcQueue,
+      m_feedback, setupContext, execGraph, execState
 #if(__cplusplus > 201703L) && !defined(_MSC_VER)
       ,
   {
@@ -66,7 +70,6 @@ DocumentPlugin::DocumentPlugin(const score::DocumentContext& ctx, QObject* paren
     , m_ctxData{std::make_shared<ContextData>(ctx)}
 {
   m_ctxData->context.alias = m_ctxData;
-  makeGraph();
   auto& devs = ctx.plugin<Explorer::DeviceDocumentPlugin>();
   local_device = devs.list().localDevice();
   if(auto dev = devs.list().audioDevice())
@@ -80,6 +83,10 @@ DocumentPlugin::DocumentPlugin(const score::DocumentContext& ctx, QObject* paren
     ctx.plugin<Explorer::DeviceDocumentPlugin>().list().setAudioDevice(audio_device);
   }
 
+  // A new device may be allocated at the address of the previous one
+  con(*audio_device, &Device::DeviceInterface::deviceChanged, this,
+      [this] { m_audioDeviceGeneration++; });
+
   devs.list().apply([this](auto& d) { on_deviceAdded(&d); });
   con(devs.list(), &Device::DeviceList::deviceAdded, this,
       &DocumentPlugin::on_deviceAdded);
@@ -91,6 +98,8 @@ DocumentPlugin::DocumentPlugin(const score::DocumentContext& ctx, QObject* paren
   connect(
       this, &DocumentPlugin::finished, this, &DocumentPlugin::on_finished,
       Qt::DirectConnection);
+
+  arm();
 }
 
 void DocumentPlugin::recreateBase()
@@ -140,6 +149,7 @@ void DocumentPlugin::on_finished()
       ExecutionCommand cmd;
       while(m_ctxData->m_editionQueue.try_dequeue(cmd))
         cmd();
+      m_ctxData->m_feedback.flush();
       GCCommand gc;
       while(m_ctxData->m_gcQueue.try_dequeue(gc))
         ;
@@ -148,7 +158,7 @@ void DocumentPlugin::on_finished()
 
   clear();
 
-  initExecState();
+  arm();
 
   for(auto& v : m_ctxData->setupContext.runtime_connections)
   {
@@ -180,6 +190,7 @@ void DocumentPlugin::timerEvent(QTimerEvent* event)
   ExecutionCommand cmd;
   while(m_ctxData->m_editionQueue.try_dequeue(cmd))
     cmd();
+  m_ctxData->m_feedback.flush();
   GCCommand gc;
   while(m_ctxData->m_gcQueue.try_dequeue(gc))
     ;
@@ -234,12 +245,18 @@ void DocumentPlugin::makeGraph()
   execState->start_date = 0; // TODO set it in the first callback
   execState->cur_date = execState->start_date;
 
-  auto& p = ossia::audio_buffer_pool::instance();
-  for(int i = 0; i < 500; i++)
+  // The pool is shared by all the documents: only grow it when needed
+  static int prewarmedBufferSize = 0;
+  if(execState->bufferSize > prewarmedBufferSize)
   {
-    auto v = p.acquire();
-    v.reserve(execState->bufferSize);
-    p.release(std::move(v));
+    auto& p = ossia::audio_buffer_pool::instance();
+    for(int i = 0; i < 500; i++)
+    {
+      auto v = p.acquire();
+      v.reserve(execState->bufferSize);
+      p.release(std::move(v));
+    }
+    prewarmedBufferSize = execState->bufferSize;
   }
 
   ossia::graph_setup_options opt;
@@ -263,10 +280,31 @@ void DocumentPlugin::makeGraph()
   else if(sched == sched_t.Dynamic)
     opt.scheduling = ossia::graph_setup_options::Dynamic;
 
-  opt.scheduling = ossia::graph_setup_options::StaticFixed;
   execGraph = ossia::make_graph(opt);
 }
 
+DocumentPlugin::GraphSetup DocumentPlugin::currentGraphSetup() const
+{
+  auto& audiosettings = this->m_context.app.settings<Audio::Settings::Model>();
+  GraphSetup s;
+  s.scheduling = settings.getScheduling();
+  s.bufferSize = audiosettings.getBufferSize();
+  s.rate = audiosettings.getRate();
+  s.threads = settings.getThreads();
+  s.parallel = settings.getParallel();
+  s.logging = settings.getLogging();
+  s.bench = settings.getBench();
+  s.audioDeviceGeneration = m_audioDeviceGeneration;
+  return s;
+}
+
+void DocumentPlugin::arm()
+{
+  makeGraph();
+  m_armedSetup = currentGraphSetup();
+  m_armed = true;
+}
+
 void DocumentPlugin::reload(bool forcePlay, Scenario::IntervalModel& cst)
 {
   if(m_base)
@@ -276,7 +314,13 @@ void DocumentPlugin::reload(bool forcePlay, Scenario::IntervalModel& cst)
       m_base->baseInterval().stop();
     }
   }
-  clear();
+
+  // The context prepared when the previous execution stopped can be used as is,
+  // unless the settings it was built with changed since.
+  const bool warm = std::exchange(m_armed, false) && !m_base
+                    && m_armedSetup == currentGraphSetup();
+  if(!warm)
+    clear();
 
   const score::DocumentContext& ctx = m_context;
   auto& settings = ctx.app.settings<Execution::Settings::Model>();
@@ -292,11 +336,20 @@ void DocumentPlugin::reload(bool forcePlay, Scenario::IntervalModel& cst)
       dev->get_protocol().start_execution();
   });
 
-  makeGraph();
+  if(!warm)
+    makeGraph();
 
   auto parent = dynamic_cast<Scenario::ScenarioInterface*>(cst.parent());
   SCORE_ASSERT(parent);
 
+  // Expensive per-process setup is done in parallel,
+  // before the components get created on this thread.
+  {
+    const auto procs = cst.findChildren<Process::ProcessModel*>();
+    ctx.app.interfaces<Execution::ProcessComponentFactoryList>().prepare(
+        {procs.begin(), procs.end()}, m_ctxData->context);
+  }
+
   recreateBase();
   m_base->init(forcePlay, BaseScenarioRefContainer{cst, *parent});
   m_ctxData->m_created = true;
@@ -323,6 +376,7 @@ void DocumentPlugin::reload(bool forcePlay, Scenario::IntervalModel& cst)
 
 void DocumentPlugin::clear()
 {
+  m_armed = false;
   if(m_ctxData)
   {
     m_ctxData->setupContext.inlets.clear();
@@ -421,6 +475,8 @@ void DocumentPlugin::runAllCommands() const
   ExecutionCommand com;
   while(m_ctxData->m_execQueue.try_dequeue(com))
     com();
+  while(m_ctxData->m_workerQueue.try_dequeue(com))
+    com();
 }
 
 void DocumentPlugin::registerAction(ExecutionAction& act)
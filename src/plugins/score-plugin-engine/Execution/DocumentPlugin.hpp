@@ -2,6 +2,7 @@
 #include "BaseScenarioComponent.hpp"
 
 #include <Process/Dataflow/Port.hpp>
+#include <Process/Execution/Feedback.hpp>
 #include <Process/ExecutionAction.hpp>
 #include <Process/ExecutionContext.hpp>
 #include <Process/ExecutionSetup.hpp>
@@ -66,7 +67,9 @@ public:
 
     ExecutionCommandQueue m_execQueue{1024};
     EditionCommandQueue m_editionQueue{1024};
+    WorkerCommandQueue m_workerQueue{1024};
     GCCommandQueue m_gcQueue{1024};
+    FeedbackTable m_feedback;
     std::atomic_bool m_created{};
 
     std::shared_ptr<ossia::graph_interface> execGraph;
@@ -121,10 +124,37 @@ private:
   void initExecState();
   void recreateBase();
 
+  // Settings the graph and execution state depend on
+  struct GraphSetup
+  {
+    QString scheduling;
+    int64_t audioDeviceGeneration{};
+    int bufferSize{};
+    int rate{};
+    int threads{};
+    bool parallel{};
+    bool logging{};
+    bool bench{};
+
+    bool operator==(const GraphSetup&) const noexcept = default;
+  };
+  GraphSetup currentGraphSetup() const;
+
+  // Prepares the graph and execution state of the next execution ahead of
+  // time, so that starting playback does not have to build them.
+  // The process components are not prepared: they belong to the
+  // BaseScenarioElement created on play, and the process plug-ins have no
+  // way to reset them in place for another execution.
+  void arm();
+
   std::shared_ptr<ContextData> m_ctxData;
   std::shared_ptr<BaseScenarioElement> m_base;
   std::vector<ExecutionAction*> m_actions;
+  GraphSetup m_armedSetup;
+  // Incremented each time the audio device recreates its ossia device
+  int64_t m_audioDeviceGeneration{};
 
   int m_tid{};
+  bool m_armed{};
 };
 }
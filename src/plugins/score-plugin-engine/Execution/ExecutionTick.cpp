@@ -54,6 +54,8 @@ struct AudioTickHelper
     ExecutionCommand com;
     while(m_context->m_execQueue.try_dequeue(com))
       com();
+    while(m_context->m_workerQueue.try_dequeue(com))
+      com();
   }
   ~AudioTickHelper()
   {
@@ -95,6 +97,19 @@ struct AudioTickHelper
       {
       }
     }
+
+    // Results of the worker threads, which do not go through the GUI thread
+    while(m_context->m_workerQueue.try_dequeue(c))
+    {
+      try
+      {
+        c();
+        m_context->m_gcQueue.enqueue(gc(std::move(c)));
+      }
+      catch(...)
+      {
+      }
+    }
   }
 
   void main_tick(const ossia::audio_tick_state& t) const
@@ -25,7 +25,7 @@ namespace Settings
 Presenter::Presenter(Model& m, View& v, QObject* parent)
     : score::GlobalSettingsPresenter{m, v, parent}
 {
-  //SETTINGS_PRESENTER(Scheduling);
+  SETTINGS_PRESENTER(Scheduling);
   //SETTINGS_PRESENTER(Ordering);
   //SETTINGS_PRESENTER(Merging);
   //SETTINGS_PRESENTER(Commit);
@@ -45,12 +45,12 @@ View::View()
   group->setLayout(lay);
 */
   // SETTINGS_UI_COMBOBOX_SETUP("Tick policy", Tick, TickPolicies{});
-  // SETTINGS_UI_COMBOBOX_SETUP(
-  //     "Scheduling policy", Scheduling, SchedulingPolicies{});
   // SETTINGS_UI_COMBOBOX_SETUP("Ordering policy", Ordering, OrderingPolicies{});
   // SETTINGS_UI_COMBOBOX_SETUP("Merging policy", Merging, MergingPolicies{});
   // SETTINGS_UI_COMBOBOX_SETUP("Commit policy", Commit, CommitPolicies{});
 
+  SETTINGS_UI_COMBOBOX_SETUP("Scheduling policy", Scheduling, SchedulingPolicies{});
+
   SETTINGS_UI_TOGGLE_SETUP(
       "Parallel\nIf this is enabled, exeuction will be separated across multiple "
       "threads.",
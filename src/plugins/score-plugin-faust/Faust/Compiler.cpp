@@ -0,0 +1,305 @@
+#include "Compiler.hpp"
+
+#include <ossia/dataflow/nodes/faust/faust_node.hpp>
+#include <ossia/detail/thread.hpp>
+
+#include <QCryptographicHash>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QStandardPaths>
+
+#include <faust/dsp/libfaust.h>
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace Faust
+{
+namespace
+{
+// Bump when the compiler options change in a way that the key does not capture
+static constexpr int factory_cache_version = 1;
+
+static bool faustIsMidi(llvm_dsp& dsp)
+{
+  struct _ final : Meta
+  {
+    bool midi{};
+    void declare(const char* key, const char* value) override
+    {
+      if(key == std::string("options")
+         && std::string(value).find("[midi:on]") != std::string::npos)
+        midi = true;
+    }
+  } meta;
+  dsp.metadata(&meta);
+
+  if(meta.midi)
+    return true;
+
+  struct _2 final : ::UI
+  {
+    bool gate{false};
+    bool freq{false};
+    bool gain{false};
+
+    void openTabBox(const char* label) override { }
+    void openHorizontalBox(const char* label) override { }
+    void openVerticalBox(const char* label) override { }
+    void closeBox() override { }
+
+    // -- active widgets
+
+    void addButton(const char* label, FAUSTFLOAT* zone) override
+    {
+      if(label == std::string("gate"))
+        gate = true;
+    }
+    void addCheckButton(const char* label, FAUSTFLOAT* zone) override { }
+    void addVerticalSlider(
+        const char* label, FAUSTFLOAT* zone, FAUSTFLOAT init, FAUSTFLOAT min,
+        FAUSTFLOAT max, FAUSTFLOAT step) override
+    {
+      if(label == std::string("freq"))
+        freq = true;
+      if(label == std::string("gain"))
+        gain = true;
+    }
+    void addHorizontalSlider(
+        const char* label, FAUSTFLOAT* zone, FAUSTFLOAT init, FAUSTFLOAT min,
+        FAUSTFLOAT max, FAUSTFLOAT step) override
+    {
+      addVerticalSlider(label, zone, init, min, max, step);
+    }
+    void addNumEntry(
+        const char* label, FAUSTFLOAT* zone, FAUSTFLOAT init, FAUSTFLOAT min,
+        FAUSTFLOAT max, FAUSTFLOAT step) override
+    {
+      if(label == std::string("freq"))
+        freq = true;
+      if(label == std::string("gain"))
+        gain = true;
+    }
+
+    // -- passive widgets
+
+    void addHorizontalBargraph(
+        const char* label, FAUSTFLOAT* zone, FAUSTFLOAT min, FAUSTFLOAT max) override
+    {
+    }
+    void addVerticalBargraph(
+        const char* label, FAUSTFLOAT* zone, FAUSTFLOAT min, FAUSTFLOAT max) override
+    {
+    }
+
+    // -- soundfiles
+
+    void
+    addSoundfile(const char* label, const char* filename, Soundfile** sf_zone) override
+    {
+    }
+
+  } ui;
+
+  dsp.buildUserInterface(&ui);
+  return ui.freq && ui.gain && ui.gate;
+}
+
+static QString factoryCachePath(
+    const CompileRequest& req, std::vector<const char*>& argv, std::string& err)
+{
+  // Expanding the program is cheap compared to compiling it,
+  // and its key changes whenever an imported library does.
+  std::string sha_key;
+  expandDSPFromString("score", req.source, argv.size(), argv.data(), sha_key, err);
+  if(sha_key.empty())
+    return {};
+
+  const auto cache
+      = QStandardPaths::writableLocation(QStandardPaths::StandardLocation::CacheLocation);
+  if(cache.isEmpty())
+    return {};
+
+  QDir cache_dir{cache};
+  if(!cache_dir.mkpath("faust") || !cache_dir.cd("faust"))
+    return {};
+
+  QCryptographicHash h{QCryptographicHash::Sha1};
+  h.addData(QByteArray::number(factory_cache_version));
+  h.addData(getCLibFaustVersion());
+  h.addData(QByteArray::fromStdString(req.triple));
+  for(auto& arg : req.arguments)
+    h.addData(QByteArray::fromStdString(arg));
+  h.addData(QByteArray::fromStdString(sha_key));
+
+  return cache_dir.absoluteFilePath(
+      QString::fromLatin1(h.result().toHex()) + QStringLiteral(".fbc"));
+}
+
+static void storeInFactoryCache(
+    llvm_dsp_factory* fac, const QString& path, const std::string& triple)
+{
+  // Written under a temporary name so that a partial file is never picked up
+  const QString tmp = path + QStringLiteral(".tmp");
+  if(!writeDSPFactoryToMachineFile(fac, tmp.toStdString(), triple)
+     || !QFile::rename(tmp, path))
+    QFile::remove(tmp);
+}
+
+static void compilePoly(
+    const CompileRequest& req, std::vector<const char*>& argv, std::string& err,
+    CompileResult& res)
+{
+  auto fac = ossia::nodes::createCustomPolyDSPFactoryFromString(
+      "score", req.source, argv.size(), argv.data(), req.triple, err, -1);
+  if(!fac)
+    return;
+
+  res.poly_factory.reset(fac);
+  res.poly_object.reset(fac->createPolyDSPInstance(4, true, true));
+}
+
+class CompilerThread
+{
+public:
+  static CompilerThread& instance()
+  {
+    static CompilerThread thread;
+    return thread;
+  }
+
+  void post(std::function<void()> task)
+  {
+    {
+      std::lock_guard lck{m_mutex};
+      m_tasks.push_back(std::move(task));
+      if(!m_thread.joinable())
+      {
+        m_running = true;
+        m_thread = std::thread{[this] {
+          ossia::set_thread_name("ossia faust");
+          this->run();
+        }};
+      }
+    }
+    m_condVar.notify_one();
+  }
+
+private:
+  ~CompilerThread()
+  {
+    {
+      std::lock_guard lck{m_mutex};
+      m_running = false;
+      m_tasks.clear();
+    }
+    m_condVar.notify_one();
+
+    if(m_thread.joinable())
+      m_thread.join();
+  }
+
+  void run()
+  {
+    for(;;)
+    {
+      std::function<void()> task;
+      {
+        std::unique_lock lck{m_mutex};
+        m_condVar.wait(lck, [this] { return !m_tasks.empty() || !m_running; });
+        if(!m_running)
+          return;
+        task = std::move(m_tasks.front());
+        m_tasks.pop_front();
+      }
+      task();
+    }
+  }
+
+  std::deque<std::function<void()>> m_tasks;
+  std::thread m_thread;
+  std::mutex m_mutex;
+  std::condition_variable m_condVar;
+  bool m_running{};
+};
+}
+
+CompileResult compile(const CompileRequest& req)
+{
+  CompileResult res;
+
+  std::vector<const char*> argv;
+  for(auto& arg : req.arguments)
+    argv.push_back(arg.c_str());
+
+  std::string err;
+  err.resize(4097);
+
+  const bool declares_midi = req.source.find("[midi:on]") != std::string::npos;
+  if(!declares_midi)
+  {
+    const QString cache = factoryCachePath(req, argv, err);
+
+    llvm_dsp_factory* fac{};
+    bool cached = false;
+    if(!cache.isEmpty() && QFile::exists(cache))
+    {
+      std::string read_err;
+      fac = readDSPFactoryFromMachineFile(cache.toStdString(), req.triple, read_err);
+      if(fac)
+        cached = true;
+      else
+        QFile::remove(cache);
+    }
+
+    if(!fac)
+      fac = createDSPFactoryFromString(
+          "score", req.source, argv.size(), argv.data(), req.triple, err, -1);
+
+    if(!fac)
+    {
+      res.error = err.c_str();
+      return res;
+    }
+
+    auto obj = fac->createDSPInstance();
+    if(obj && !faustIsMidi(*obj))
+    {
+      // Only mono factories are cached: the polyphonic ones are not serializable
+      if(!cached && !cache.isEmpty())
+        storeInFactoryCache(fac, cache, req.triple);
+
+      res.object.reset(obj);
+      res.factory.reset(fac, deleteDSPFactory);
+      res.error = err.c_str();
+      return res;
+    }
+
+    delete obj;
+    deleteDSPFactory(fac);
+  }
+
+  compilePoly(req, argv, err, res);
+  res.error = err.c_str();
+  return res;
+}
+
+std::shared_future<CompileResult>
+compileAsync(CompileRequest req, std::function<void()> onReady)
+{
+  auto promise = std::make_shared<std::promise<CompileResult>>();
+  std::shared_future<CompileResult> future = promise->get_future().share();
+
+  CompilerThread::instance().post(
+      [req = std::move(req), onReady = std::move(onReady), promise] {
+    promise->set_value(compile(req));
+    if(onReady)
+      onReady();
+  });
+
+  return future;
+}
+}
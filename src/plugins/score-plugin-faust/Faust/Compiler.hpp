@@ -0,0 +1,58 @@
+#pragma once
+#include <iostream> // needed by llvm-dsp.h...
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <faust/dsp/llvm-dsp.h>
+
+namespace ossia::nodes
+{
+struct custom_dsp_poly_factory;
+class custom_dsp_poly_effect;
+}
+
+namespace Faust
+{
+struct CompileRequest
+{
+  std::string source;
+  std::vector<std::string> arguments;
+  std::string triple;
+};
+
+//! Either the mono or the polyphonic pair is set, depending on the program
+struct CompileResult
+{
+  std::shared_ptr<llvm_dsp_factory> factory;
+  std::shared_ptr<llvm_dsp> object;
+
+  std::shared_ptr<ossia::nodes::custom_dsp_poly_factory> poly_factory;
+  std::shared_ptr<ossia::nodes::custom_dsp_poly_effect> poly_object;
+
+  std::string error;
+};
+
+/**
+ * @brief Compiles a Faust program.
+ *
+ * Mono factories are stored on disk as machine code, keyed by the expanded
+ * program (which covers the imported libraries), the compiler options, the
+ * target and the Faust version: a program which was already compiled once
+ * is only parsed and loaded back.
+ *
+ * Programs which declare [midi:on] are compiled as polyphonic synths
+ * directly, instead of being compiled a first time to find that out.
+ */
+CompileResult compile(const CompileRequest& req);
+
+/**
+ * @brief Compiles on the Faust compiler thread.
+ *
+ * onReady is called on that thread once the result is available.
+ */
+std::shared_future<CompileResult>
+compileAsync(CompileRequest req, std::function<void()> onReady);
+}
@@ -18,15 +18,18 @@
 #include <ossia/dataflow/execution_state.hpp>
 #include <ossia/dataflow/nodes/faust/faust_node.hpp>
 
+#include <QCoreApplication>
 #include <QDialog>
 #include <QDialogButtonBox>
 #include <QDirIterator>
 #include <QFileInfo>
 #include <QPlainTextEdit>
+#include <QPointer>
 #include <QTimer>
 #include <QVBoxLayout>
 
 #include <Faust/Commands.hpp>
+#include <Faust/Compiler.hpp>
 #include <Faust/Utils.hpp>
 
 #include <wobjectimpl.h>
@@ -111,102 +114,14 @@ QString FaustEffectModel::prettyName() const noexcept
   return m_declareName.isEmpty() ? "Faust" : m_declareName;
 }
 
-static bool faustIsMidi(llvm_dsp& dsp)
+CompileRequest FaustEffectModel::updateProgram()
 {
-  struct _ final : Meta
-  {
-    bool midi{};
-    void declare(const char* key, const char* value) override
-    {
-      if(key == std::string("options")
-         && std::string(value).find("[midi:on]") != std::string::npos)
-        midi = true;
-    }
-  } meta;
-  dsp.metadata(&meta);
-
-  if(meta.midi)
-    return true;
-
-  struct _2 final : ::UI
-  {
-    bool gate{false};
-    bool freq{false};
-    bool gain{false};
-
-    void openTabBox(const char* label) override { }
-    void openHorizontalBox(const char* label) override { }
-    void openVerticalBox(const char* label) override { }
-    void closeBox() override { }
-
-    // -- active widgets
-
-    void addButton(const char* label, FAUSTFLOAT* zone) override
-    {
-      if(label == std::string("gate"))
-        gate = true;
-    }
-    void addCheckButton(const char* label, FAUSTFLOAT* zone) override { }
-    void addVerticalSlider(
-        const char* label, FAUSTFLOAT* zone, FAUSTFLOAT init, FAUSTFLOAT min,
-        FAUSTFLOAT max, FAUSTFLOAT step) override
-    {
-      if(label == std::string("freq"))
-        freq = true;
-      if(label == std::string("gain"))
-        gain = true;
-    }
-    void addHorizontalSlider(
-        const char* label, FAUSTFLOAT* zone, FAUSTFLOAT init, FAUSTFLOAT min,
-        FAUSTFLOAT max, FAUSTFLOAT step) override
-    {
-      addVerticalSlider(label, zone, init, min, max, step);
-    }
-    void addNumEntry(
-        const char* label, FAUSTFLOAT* zone, FAUSTFLOAT init, FAUSTFLOAT min,
-        FAUSTFLOAT max, FAUSTFLOAT step) override
-    {
-      if(label == std::string("freq"))
-        freq = true;
-      if(label == std::string("gain"))
-        gain = true;
-    }
-
-    // -- passive widgets
-
-    void addHorizontalBargraph(
-        const char* label, FAUSTFLOAT* zone, FAUSTFLOAT min, FAUSTFLOAT max) override
-    {
-    }
-    void addVerticalBargraph(
-        const char* label, FAUSTFLOAT* zone, FAUSTFLOAT min, FAUSTFLOAT max) override
-    {
-    }
-
-    // -- soundfiles
-
-    void
-    addSoundfile(const char* label, const char* filename, Soundfile** sf_zone) override
-    {
-    }
-
-  } ui;
-
-  dsp.buildUserInterface(&ui);
-  return ui.freq && ui.gain && ui.gate;
-}
-
-Process::ScriptChangeResult FaustEffectModel::reload()
-{
-  Process::ScriptChangeResult res;
   auto& ctx = score::IDocument::documentContext(*this);
-  score::delete_later<Process::Inlets>& inlets_to_clear = res.inlets;
-  score::delete_later<Process::Outlets>& outlets_to_clear = res.outlets;
 
   auto fx_text = m_script.toUtf8();
   if(fx_text.isEmpty())
   {
-    return res;
+    return {};
   }
 
   if(QFile f{fx_text}; f.open(QIODevice::ReadOnly))
@@ -222,7 +137,30 @@ Process::ScriptChangeResult FaustEffectModel::reload()
     m_declareName = QStringLiteral("Faust");
   }
 
-  const char* triple =
+  auto lines = fx_text.split('\n');
+  for(int i = 0; i < std::min(5, int(lines.size())); i++)
+  {
+    if(lines[i].startsWith("declare name"))
+    {
+      auto s = lines[i].indexOf('"', 12);
+      if(s > 0)
+      {
+        auto e = lines[i].indexOf('"', s + 1);
+        if(e > s)
+        {
+          m_declareName = lines[i].mid(s + 1, e - s - 1);
+          prettyNameChanged();
+        }
+      }
+      break;
+    }
+  }
+
+  metadata().setName(m_declareName);
+  metadata().setLabel(m_declareName);
+
+  CompileRequest req;
+  req.triple =
 #if defined(_WIN32)
       "x86_64-pc-windows-msvc"
 #elif defined(__emscripten__)
@@ -236,128 +174,167 @@ Process::ScriptChangeResult FaustEffectModel::reload()
 #endif
       ;
 
-  std::string fx_path = score::locateFilePath(m_path, ctx).toStdString();
-  auto str = fx_text.toStdString();
+  req.source = fx_text.toStdString();
 
-  std::vector<const char*> argv;
-  argv.push_back(sizeof(FAUSTFLOAT) == 4 ? "-single" : "-double");
-  argv.push_back("-vec");
+  req.arguments.push_back(sizeof(FAUSTFLOAT) == 4 ? "-single" : "-double");
+  req.arguments.push_back("-vec");
 
-  if(!fx_path.empty())
+  if(std::string fx_path = score::locateFilePath(m_path, ctx).toStdString();
+     !fx_path.empty())
   {
-    argv.push_back("-I");
-    argv.push_back(fx_path.c_str());
+    req.arguments.push_back("-I");
+    req.arguments.push_back(std::move(fx_path));
   }
 
-  const auto libPaths = getLibpaths();
-  for(auto& lib : libPaths)
+  for(auto& lib : getLibpaths())
   {
-    argv.push_back("-I");
-    argv.push_back(lib.c_str());
+    req.arguments.push_back("-I");
+    req.arguments.push_back(std::move(lib));
   }
 
-  std::string err;
-  err.resize(4097);
-  llvm_dsp_factory* fac{};
+  return req;
+}
 
-  fac = createDSPFactoryFromString(
-      "score", str, argv.size(), argv.data(), triple, err, -1);
+Process::ScriptChangeResult FaustEffectModel::reload()
+{
+  // Supersedes a compilation which was still running
+  m_compilation = {};
 
-  if(err[0] != 0)
+  auto req = updateProgram();
+  if(req.source.empty())
+    return {};
+
+  return applyCompilation(compile(req));
+}
+
+void FaustEffectModel::reloadAsync()
+{
+  auto req = updateProgram();
+  if(req.source.empty())
+    return;
+
+  // The result is applied on the GUI thread as soon as it is available,
+  // or earlier if execution needs it, see finishCompilation.
+  m_compilation = compileAsync(std::move(req), [self = QPointer{this}] {
+    QMetaObject::invokeMethod(
+        qApp,
+        [self] {
+      if(self && self->m_compilation.valid()
+         && self->m_compilation.wait_for(std::chrono::seconds(0))
+                == std::future_status::ready)
+        self->finishCompilation();
+    },
+        Qt::QueuedConnection);
+  });
+}
+
+void FaustEffectModel::finishCompilation()
+{
+  if(!m_compilation.valid())
+    return;
+
+  auto res = m_compilation.get();
+  m_compilation = {};
+
+  const auto inlets = m_inlets.size();
+  const auto outlets = m_outlets.size();
+  auto changes = applyCompilation(res);
+
+  // The presenters may already show the ports which were replaced
+  if(inlets != m_inlets.size() || !changes.inlets.container.empty())
+    inletsChanged();
+  if(outlets != m_outlets.size() || !changes.outlets.container.empty())
+    outletsChanged();
+}
+
+Process::ScriptChangeResult FaustEffectModel::applyCompilation(const CompileResult& dsp)
+{
+  Process::ScriptChangeResult res;
+  score::delete_later<Process::Inlets>& inlets_to_clear = res.inlets;
+  score::delete_later<Process::Outlets>& outlets_to_clear = res.outlets;
+
+  if(!dsp.error.empty())
   {
-    errorMessage(0, QString::fromStdString(err));
-    qDebug() << "Faust error: " << err;
+    errorMessage(0, QString::fromStdString(dsp.error));
+    qDebug() << "Faust error: " << dsp.error;
   }
 
-  if(!fac)
+  if(!dsp.poly_object && !dsp.object)
   {
     // TODO mark as invalid, like JS
     return res;
   }
+  m_dspGeneration++;
 
-  auto obj = fac->createDSPInstance();
-  if(!obj)
-    return res;
+  if(dsp.poly_object)
+  {
+    static std::vector<std::shared_ptr<ossia::nodes::custom_dsp_poly_factory>>
+        dsp_poly_factories;
+    const bool had_dsp = bool(faust_object);
+    const bool had_poly_dsp = bool(faust_poly_object);
+    faust_poly_object = dsp.poly_object;
+    faust_poly_factory = dsp.poly_factory;
 
-  res.valid = true;
+    faust_object.reset();
+    faust_factory.reset();
 
-  if(faustIsMidi(*obj))
-  {
-    delete obj;
-    deleteDSPFactory(fac);
-    fac = nullptr;
+    res.valid = true;
+
+    dsp_poly_factories.push_back(faust_poly_factory);
+    Process::Inlets toRemove;
+    Process::Outlets toRemoveO;
+    if(had_poly_dsp)
     {
-      auto midi_fac = ossia::nodes::createCustomPolyDSPFactoryFromString(
-          "score", str, argv.size(), argv.data(), triple, err, -1);
-      auto midi_obj = midi_fac->createPolyDSPInstance(4, true, true);
+      // updating an existing DSP
+      // Try to reuse controls
+      Faust::UpdateUI<decltype(*this), true> ui{*this, toRemove, toRemoveO};
+      ui.i = 2;
+      ui.o = 1;
+      faust_poly_object->buildUserInterface(&ui);
+
+      for(std::size_t i = ui.i; i < m_inlets.size(); i++)
       {
-        auto fac = midi_fac;
-        auto obj = midi_obj;
-
-        static std::vector<std::shared_ptr<ossia::nodes::custom_dsp_poly_factory>>
-            dsp_poly_factories;
-        const bool had_dsp = bool(faust_object);
-        const bool had_poly_dsp = bool(faust_poly_object);
-        faust_poly_object.reset(obj);
-        faust_poly_factory.reset(fac);
-
-        faust_object.reset();
-        faust_factory.reset();
-
-        dsp_poly_factories.push_back(faust_poly_factory);
-        Process::Inlets toRemove;
-        Process::Outlets toRemoveO;
-        if(had_poly_dsp)
-        {
-          // updating an existing DSP
-          // Try to reuse controls
-          Faust::UpdateUI<decltype(*this), true> ui{*this, toRemove, toRemoveO};
-          ui.i = 2;
-          ui.o = 1;
-          faust_poly_object->buildUserInterface(&ui);
-
-          for(std::size_t i = ui.i; i < m_inlets.size(); i++)
-          {
-            toRemove.push_back(m_inlets[i]);
-          }
-          m_inlets.resize(ui.i);
-
-          for(std::size_t i = ui.o; i < m_outlets.size(); i++)
-          {
-            toRemoveO.push_back(m_outlets[i]);
-          }
-          m_outlets.resize(ui.o);
-
-          score::clearAndDeleteLater(toRemove, inlets_to_clear);
-          score::clearAndDeleteLater(toRemoveO, outlets_to_clear);
-        }
-        else if((!m_inlets.empty() || !m_outlets.empty()) && !had_poly_dsp && !had_dsp)
-        {
-          // Try to reuse controls
-          Faust::UpdateUI<decltype(*this), false> ui{*this, toRemove, toRemoveO};
-          ui.i = 2;
-          ui.o = 1;
-          faust_poly_object->buildUserInterface(&ui);
-        }
-        else
-        {
-          score::clearAndDeleteLater(m_inlets, inlets_to_clear);
-          score::clearAndDeleteLater(m_outlets, outlets_to_clear);
+        toRemove.push_back(m_inlets[i]);
+      }
+      m_inlets.resize(ui.i);
 
-          m_inlets.push_back(new Process::AudioInlet{getStrongId(m_inlets), this});
-          m_inlets.push_back(new Process::MidiInlet{getStrongId(m_inlets), this});
+      for(std::size_t i = ui.o; i < m_outlets.size(); i++)
+      {
+        toRemoveO.push_back(m_outlets[i]);
+      }
+      m_outlets.resize(ui.o);
 
-          auto out = new Process::AudioOutlet{getStrongId(m_outlets), this};
-          out->setPropagate(true);
-          m_outlets.push_back(out);
+      score::clearAndDeleteLater(toRemove, inlets_to_clear);
+      score::clearAndDeleteLater(toRemoveO, outlets_to_clear);
+    }
+    else if((!m_inlets.empty() || !m_outlets.empty()) && !had_poly_dsp && !had_dsp)
+    {
+      // Try to reuse controls
+      Faust::UpdateUI<decltype(*this), false> ui{*this, toRemove, toRemoveO};
+      ui.i = 2;
+      ui.o = 1;
+      faust_poly_object->buildUserInterface(&ui);
 
-          Faust::UI<decltype(*this), true> ui{*this};
-          faust_poly_object->buildUserInterface(&ui);
-        }
-      }
+      score::clearAndDeleteLater(toRemove, inlets_to_clear);
+      score::clearAndDeleteLater(toRemoveO, outlets_to_clear);
+    }
+    else
+    {
+      score::clearAndDeleteLater(m_inlets, inlets_to_clear);
+      score::clearAndDeleteLater(m_outlets, outlets_to_clear);
+
+      m_inlets.push_back(new Process::AudioInlet{getStrongId(m_inlets), this});
+      m_inlets.push_back(new Process::MidiInlet{getStrongId(m_inlets), this});
+
+      auto out = new Process::AudioOutlet{getStrongId(m_outlets), this};
+      out->setPropagate(true);
+      m_outlets.push_back(out);
+
+      Faust::UI<decltype(*this), true> ui{*this};
+      faust_poly_object->buildUserInterface(&ui);
     }
   }
-  else
+  else if(dsp.object)
   {
     static std::vector<std::shared_ptr<llvm_dsp_factory>> dsp_factories;
     const bool had_dsp = bool(faust_object);
@@ -365,8 +342,10 @@ Process::ScriptChangeResult FaustEffectModel::reload()
     faust_poly_object.reset();
     faust_poly_factory.reset();
 
-    faust_object.reset(obj);
-    faust_factory.reset(fac, deleteDSPFactory);
+    faust_object = dsp.object;
+    faust_factory = dsp.factory;
+
+    res.valid = true;
 
     dsp_factories.push_back(faust_factory);
     Process::Inlets toRemove;
@@ -397,6 +376,9 @@ Process::ScriptChangeResult FaustEffectModel::reload()
       // loading - controls already exist but not linked to the dsp
       Faust::UpdateUI<decltype(*this), false> ui{*this, toRemove, toRemoveO};
       faust_object->buildUserInterface(&ui);
+
+      score::clearAndDeleteLater(toRemove, inlets_to_clear);
+      score::clearAndDeleteLater(toRemoveO, outlets_to_clear);
     }
     else
     {
@@ -414,28 +396,6 @@ Process::ScriptChangeResult FaustEffectModel::reload()
     }
   }
 
-  auto lines = fx_text.split('\n');
-  for(int i = 0; i < std::min(5, int(lines.size())); i++)
-  {
-    if(lines[i].startsWith("declare name"))
-    {
-      auto s = lines[i].indexOf('"', 12);
-      if(s > 0)
-      {
-        auto e = lines[i].indexOf('"', s + 1);
-        if(e > s)
-        {
-          m_declareName = lines[i].mid(s + 1, e - s - 1);
-          prettyNameChanged();
-        }
-      }
-      break;
-    }
-  }
-
-  metadata().setName(m_declareName);
-  metadata().setLabel(m_declareName);
-
   return res;
 }
 
@@ -467,7 +427,7 @@ template <>
 void DataStreamWriter::write(Faust::FaustEffectModel& eff)
 {
   m_stream >> eff.m_script >> eff.m_path;
-  eff.reload();
+  eff.reloadAsync();
   writePorts(
       *this, components.interfaces<Process::PortFactoryList>(), eff.m_inlets,
       eff.m_outlets, &eff);
@@ -487,7 +447,7 @@ void JSONWriter::write(Faust::FaustEffectModel& eff)
   eff.m_script = obj["Text"].toString();
   if(auto path_it = obj.tryGet("Path"))
     eff.m_path = path_it->toString();
-  eff.reload();
+  eff.reloadAsync();
   writePorts(
       *this, components.interfaces<Process::PortFactoryList>(), eff.m_inlets,
       eff.m_outlets, &eff);
@@ -529,6 +489,9 @@ FaustEffectComponent::FaustEffectComponent(
   },
       Qt::DirectConnection);
 
+  // The program may still be compiling if the document was just loaded
+  proc.finishCompilation();
+
   Execution::Transaction commands{ctx};
   reload(commands);
   commands.run_all();
@@ -654,7 +617,8 @@ void FaustEffectComponent::reloadSynth(Execution::Transaction& transaction)
   auto& proc = process();
   auto& ctx = system();
 
-  proc.faust_poly_object->init(ctx.execState->sampleRate);
+  if(!proc.takePreparedDsp(ctx.execState->sampleRate))
+    proc.faust_poly_object->init(ctx.execState->sampleRate);
   auto node = ossia::make_node<faust_type>(*ctx.execState, proc.faust_poly_object);
   this->node = node;
 
@@ -671,7 +635,8 @@ void FaustEffectComponent::reloadFx(Execution::Transaction& transaction)
 {
   auto& proc = process();
   auto& ctx = system();
-  proc.faust_object->init(ctx.execState->sampleRate);
+  if(!proc.takePreparedDsp(ctx.execState->sampleRate))
+    proc.faust_object->init(ctx.execState->sampleRate);
 
   auto setup = [&](auto& node) {
     this->node = node;
@@ -697,5 +662,30 @@ void FaustEffectComponent::reloadFx(Execution::Transaction& transaction)
   }
 }
 
+
+void FaustEffectComponentFactory::prepare(
+    Process::ProcessModel& p, const Execution::Context& ctx) const
+{
+  auto& proc = static_cast<Faust::FaustEffectModel&>(p);
+  const int rate = ctx.execState->sampleRate;
+
+  // A pending result is applied to the model on the GUI thread when the component
+  // gets created, and its DSP initialized only then.
+  // The DSPs already applied are not touched by the GUI thread while it waits for
+  // the preparation.
+  if(proc.pendingCompilation().valid())
+    return;
+
+  if(auto& dsp = proc.faust_object)
+  {
+    dsp->init(rate);
+    proc.setPreparedDsp(rate);
+  }
+  else if(auto& dsp = proc.faust_poly_object)
+  {
+    dsp->init(rate);
+    proc.setPreparedDsp(rate);
+  }
+}
 }
 W_OBJECT_IMPL(Execution::FaustEffectComponent)
@@ -18,6 +18,7 @@
 #include <verdigris>
 
 #include <faust/dsp/poly-llvm-dsp.h>
+#include <Faust/Compiler.hpp>
 namespace Faust
 {
 class FaustEffectModel;
@@ -78,6 +79,27 @@ public:
   std::shared_ptr<ossia::nodes::custom_dsp_poly_factory> faust_poly_factory{};
   std::shared_ptr<ossia::nodes::custom_dsp_poly_effect> faust_poly_object{};
 
+  // Set when the DSP instance got initialized ahead of execution,
+  // see FaustEffectComponentFactory::prepare
+  void setPreparedDsp(int rate) noexcept
+  {
+    m_preparedDsp = m_dspGeneration;
+    m_preparedRate = rate;
+  }
+  bool takePreparedDsp(int rate) noexcept
+  {
+    const bool ok = m_preparedDsp == m_dspGeneration && rate == m_preparedRate;
+    m_preparedDsp = -1;
+    return ok;
+  }
+
+  //! Applies the result of the compilation started when loading, waiting for it
+  void finishCompilation();
+  const std::shared_future<CompileResult>& pendingCompilation() const noexcept
+  {
+    return m_compilation;
+  }
+
   void scriptChanged(const QString& str) W_SIGNAL(scriptChanged, str);
   void programChanged() W_SIGNAL(programChanged);
 
@@ -91,10 +113,20 @@ private:
 
   void init();
   [[nodiscard]] Process::ScriptChangeResult reload();
+  void reloadAsync();
+  CompileRequest updateProgram();
+  [[nodiscard]] Process::ScriptChangeResult applyCompilation(const CompileResult& dsp);
 
   QString m_script;
   QString m_path;
   QString m_declareName;
+
+  std::shared_future<CompileResult> m_compilation;
+
+  // Incremented whenever faust_object or faust_poly_object is replaced
+  int64_t m_dspGeneration{};
+  int64_t m_preparedDsp{-1};
+  int m_preparedRate{};
 };
 }
 
@@ -149,6 +181,12 @@ private:
 
   std::vector<QMetaObject::Connection> m_controlConnections;
 };
-using FaustEffectComponentFactory
-    = Execution::ProcessComponentFactory_T<FaustEffectComponent>;
+class FaustEffectComponentFactory final
+    : public Execution::ProcessComponentFactory_T<FaustEffectComponent>
+{
+public:
+  // Initializing the DSP fills its tables and delay lines, which can take a while
+  void
+  prepare(Process::ProcessModel& proc, const Execution::Context& ctx) const override;
+};
 }
@@ -0,0 +1,223 @@
+#pragma once
+#include <score/tools/ThreadPool.hpp>
+
+#include <ossia/detail/lockfree_queue.hpp>
+
+#include <QDebug>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace Nodes::AudioLooper
+{
+/**
+ * @brief Append-only audio storage for the looper.
+ *
+ * Each channel is a list of fixed-size chunks. Chunks are allocated on the
+ * task pool ahead of the write head and handed to the audio thread through
+ * a lock-free queue: growing the recording never allocates nor copies on
+ * the audio thread. Once the maximum length is reached, recording wraps
+ * around and overwrites the beginning of the loop; if the allocation lags
+ * behind instead, resize reports it, and the next background allocation logs
+ * it so that the audio thread does not have to.
+ *
+ * All the member functions are meant to be called from the audio thread,
+ * except the constructor and set_channels when adding channels.
+ */
+class LoopBuffer
+{
+public:
+  static constexpr int64_t chunk_samples = 1 << 16;
+  static constexpr int64_t max_chunks = 4096; // ~1.5 hour at 48kHz
+
+  // How many chunks are kept available after the write head of each channel
+  static constexpr int64_t chunks_ahead = 8;
+
+  explicit LoopBuffer(int channels = 2)
+      : m_pool{std::make_shared<Pool>()}
+  {
+    set_channels(channels);
+  }
+
+  int channels() const noexcept { return m_channels; }
+
+  //! Allocates when channels are added, which only happens when the inputs change
+  void set_channels(int chans)
+  {
+    const int prev_channels = m_channels;
+    m_channels = chans;
+
+    for(int64_t i = std::ssize(m_chunks); i < chans; i++)
+      m_chunks.emplace_back().reserve(max_chunks);
+
+    // Channels which come back missed the growth of the recording meanwhile
+    const int64_t needed = std::min(chunk_count(m_size) + chunks_ahead, max_chunks);
+    for(int c = prev_channels; c < chans; c++)
+    {
+      auto& chan = m_chunks[c];
+      std::unique_ptr<float[]> chunk;
+      while(std::ssize(chan) < needed)
+      {
+        if(!m_pool->chunks.try_dequeue(chunk))
+          chunk = std::make_unique<float[]>(chunk_samples);
+        chan.push_back(std::move(chunk));
+      }
+    }
+
+    // Channels which come back start silent
+    for(int c = prev_channels; c < chans; c++)
+      for_each_span(c, 0, m_size, m_size, [](float* s, int64_t n, int64_t) {
+        std::fill_n(s, n, 0.f);
+      });
+  }
+
+  //! Recorded samples per channel
+  int64_t size() const noexcept { return m_size; }
+
+  int64_t max_size() const noexcept { return m_maxSize; }
+  void set_max_size(int64_t samples) noexcept
+  {
+    m_maxSize = std::clamp(samples, int64_t(1), max_chunks * chunk_samples);
+    m_size = std::min(m_size, m_maxSize);
+  }
+
+  /**
+   * @brief Sets the recorded length, the new samples being silent.
+   *
+   * The length is limited to the maximum size, and to the chunks which are
+   * available at this point if the background allocation could not keep up:
+   * false is returned in that case.
+   */
+  bool resize(int64_t samples) noexcept
+  {
+    samples = std::clamp(samples, int64_t(0), m_maxSize);
+    reserve(samples);
+
+    const int64_t avail = available();
+    const bool allocated = samples <= avail;
+    samples = std::min(samples, avail);
+
+    if(samples > m_size)
+    {
+      for(int c = 0; c < m_channels; c++)
+        for_each_span(
+            c, m_size, samples - m_size, samples, [](float* s, int64_t n, int64_t) {
+          std::fill_n(s, n, 0.f);
+        });
+    }
+    m_size = samples;
+
+    // Only flagged at the beginning of a lag, the log is written by the pool
+    if(!allocated && !m_lagging)
+      m_pool->lagged.store(true, std::memory_order_relaxed);
+    m_lagging = !allocated;
+    return allocated;
+  }
+
+  float& sample(int chan, int64_t pos) noexcept
+  {
+    return m_chunks[chan][pos / chunk_samples][pos % chunk_samples];
+  }
+
+  //! Copies n samples to the buffer, wrapping around past the recorded length
+  void write(int chan, int64_t pos, const double* src, int64_t n) noexcept
+  {
+    for_each_span(chan, pos, n, m_size, [src](float* s, int64_t count, int64_t offset) {
+      std::copy_n(src + offset, count, s);
+    });
+  }
+
+  //! Copies n samples from the buffer, wrapping around past the recorded length
+  void read(int chan, int64_t pos, double* dst, int64_t n) const noexcept
+  {
+    for_each_span(chan, pos, n, m_size, [dst](float* s, int64_t count, int64_t offset) {
+      std::copy_n(s, count, dst + offset);
+    });
+  }
+
+private:
+  struct Pool
+  {
+    ossia::mpmc_queue<std::unique_ptr<float[]>> chunks;
+    std::atomic_bool requested{};
+    std::atomic_bool lagged{};
+
+    // The requests are posted from the audio thread
+    score::TaskPool::Producer producer{score::TaskPool::instance()};
+  };
+
+  static constexpr int64_t chunk_count(int64_t samples) noexcept
+  {
+    return (samples + chunk_samples - 1) / chunk_samples;
+  }
+
+  //! Samples which can be stored in every channel with the current chunks
+  int64_t available() const noexcept
+  {
+    int64_t chunks = max_chunks;
+    for(int c = 0; c < m_channels; c++)
+      chunks = std::min(chunks, int64_t(std::ssize(m_chunks[c])));
+    return std::min(chunks * chunk_samples, m_maxSize);
+  }
+
+  void reserve(int64_t samples) noexcept
+  {
+    const int64_t wanted = std::min(chunk_count(samples) + chunks_ahead, max_chunks);
+
+    // Take the chunks which were allocated in the background
+    int64_t missing = 0;
+    for(int c = 0; c < m_channels; c++)
+    {
+      auto& chan = m_chunks[c];
+      std::unique_ptr<float[]> chunk;
+      while(std::ssize(chan) < wanted && m_pool->chunks.try_dequeue(chunk))
+        chan.push_back(std::move(chunk));
+      missing += std::max(int64_t(0), wanted - int64_t(std::ssize(chan)));
+    }
+
+    // Ask for more: at most one request is in flight at once
+    if(missing > 0 && !m_pool->requested.exchange(true, std::memory_order_acq_rel))
+    {
+      const int64_t count = missing + chunks_ahead * m_channels;
+      m_pool->producer.post([pool = m_pool, count] {
+        for(int64_t i = 0; i < count; i++)
+          pool->chunks.enqueue(std::make_unique<float[]>(chunk_samples));
+        pool->requested.store(false, std::memory_order_release);
+
+        if(pool->lagged.exchange(false, std::memory_order_relaxed))
+          qDebug("Looper: memory allocation cannot keep up, dropping the recording");
+      }, score::TaskPool::Priority::High);
+    }
+  }
+
+  // Calls f(samples, count, offset) on the contiguous parts of [pos, pos + n),
+  // positions past length wrapping around to the beginning
+  template <typename F>
+  void
+  for_each_span(int chan, int64_t pos, int64_t n, int64_t length, F&& f) const noexcept
+  {
+    if(length <= 0)
+      return;
+
+    auto& chunks = m_chunks[chan];
+    for(int64_t offset = 0; offset < n;)
+    {
+      const int64_t p = pos % length;
+      const int64_t in_chunk = p % chunk_samples;
+      const int64_t count = std::min({n - offset, chunk_samples - in_chunk, length - p});
+      f(chunks[p / chunk_samples].get() + in_chunk, count, offset);
+      pos += count;
+      offset += count;
+    }
+  }
+
+  std::vector<std::vector<std::unique_ptr<float[]>>> m_chunks;
+  std::shared_ptr<Pool> m_pool;
+  int64_t m_size{};
+  int64_t m_maxSize{max_chunks * chunk_samples};
+  int m_channels{};
+  bool m_lagging{};
+};
+}
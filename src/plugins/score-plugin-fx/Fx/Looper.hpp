@@ -1,6 +1,8 @@
 #pragma once
 #include <Engine/Node/SimpleApi.hpp>
 
+#include <Fx/LoopBuffer.hpp>
+
 namespace Nodes::AudioLooper
 {
 struct Node
@@ -32,7 +34,7 @@ struct Node
   {
     Control::Widgets::LoopMode quantizedPlayMode{Control::Widgets::LoopMode::Stop};
     Control::Widgets::LoopMode actualMode{Control::Widgets::LoopMode::Stop};
-    ossia::audio_vector audio;
+    LoopBuffer audio;
     int64_t playbackPos{};
     ossia::time_value recordStart{};
     ossia::quarter_note recordStartBar{-1.};
@@ -45,39 +47,23 @@ struct Node
     double sampleRate{48000.};
     bool isPostRecording{false};
 
-    static constexpr int64_t default_buffer_size = 192000 * 32;
     void reset_elapsed() { }
     int channels() const noexcept { return actualChannels; }
     void set_channels(int chans)
     {
-      const int64_t cur_channels = std::ssize(audio);
       actualChannels = chans;
-      if(actualChannels > cur_channels)
-      {
-        audio.resize(actualChannels);
-
-        int64_t min_size = audio[0].size();
-        int64_t min_capa = std::max(int64_t(audio[0].capacity()), default_buffer_size);
-        for(int i = cur_channels; i < actualChannels; i++)
-        {
-          audio[i].reserve(min_capa);
-          audio[i].resize(min_size);
-        }
-      }
-      else if(actualChannels < cur_channels)
-      {
-        for(int i = actualChannels; i < cur_channels; i++)
-        {
-          audio[i].resize(0);
-        }
-      }
+      audio.set_channels(chans);
     }
 
-    State()
+    //! Grows the recording for the samples to come, returns how many of them fit
+    int64_t grow(int64_t samples)
     {
-      audio.resize(2);
-      for(auto& vec : audio)
-        vec.reserve(default_buffer_size);
+      if(audio.resize(playbackPos + samples))
+        return samples;
+
+      // The samples which do not fit are dropped rather than written over the
+      // beginning of the loop
+      return std::max(int64_t(0), audio.size() - playbackPos);
     }
   };
 
@@ -92,30 +78,27 @@ struct Node
     const bool quantify_length = (state.quantif > 0.f) && (state.channels() > 0);
     if(quantify_length)
     {
-      if(total_samples < state.audio[0].size())
-      {
-        for(auto& a : state.audio)
-          a.resize(total_samples);
-      }
+      if(total_samples < state.audio.size())
+        state.audio.resize(total_samples);
     }
 
     // Apply a small fade on the first and last samples
-    for(auto& chan : state.audio)
+    const int64_t samples = state.audio.size();
+    for(int c = 0; c < state.audio.channels(); c++)
     {
-      int samples = chan.size();
-      if(int min_n = std::min(samples, (int)128); min_n > 0)
+      if(int64_t min_n = std::min(samples, (int64_t)128); min_n > 0)
       {
         float f = 1. / min_n;
         float ff = 0.;
-        for(int i = 0; i < min_n; i++)
+        for(int64_t i = 0; i < min_n; i++)
         {
-          chan[i] *= ff;
+          state.audio.sample(c, i) *= ff;
           ff += f;
         }
 
-        for(int i = samples - min_n; i < samples; i++)
+        for(int64_t i = samples - min_n; i < samples; i++)
         {
-          chan[i] *= ff;
+          state.audio.sample(c, i) *= ff;
           ff -= f;
         }
       }
@@ -124,11 +107,8 @@ struct Node
     // If there are less samples than expected we extend
     if(quantify_length)
     {
-      if(total_samples > state.audio[0].size())
-      {
-        for(auto& a : state.audio)
-          a.resize(total_samples);
-      }
+      if(total_samples > state.audio.size())
+        state.audio.resize(total_samples);
     }
   }
 
@@ -359,7 +339,7 @@ struct Node
     switch(state.actualMode)
     {
       case Control::Widgets::LoopMode::Play:
-        if(state.channels() == 0 || state.audio[0].size() == 0)
+        if(state.channels() == 0 || state.audio.size() == 0)
           stop(p1, p2, state, start, length);
         else
           play(p1, p2, state, start, length);
@@ -389,31 +369,32 @@ struct Node
     if(chans == 0)
       return;
 
+    // The loop is read by contiguous spans of the recording
+    const int64_t chan_samples = state.audio.size();
     int64_t k = state.playbackPos;
     for(int i = 0; i < chans; i++)
     {
       auto& out = p2.channel(i);
-      auto& record = state.audio[i];
-      const int64_t chan_samples = record.size();
 
       out.resize(N);
       k = state.playbackPos;
       if(state.playbackPos + N < chan_samples)
       {
-        for(int64_t j = first_pos; j < N; j++)
+        if(const int64_t n = N - first_pos; n > 0)
         {
-          out[j] = record[k];
-          k++;
+          state.audio.read(i, k, out.data() + first_pos, n);
+          k += n;
         }
       }
       else
       {
         int64_t max = chan_samples - state.playbackPos;
         int64_t j = first_pos;
-        for(; j < max; j++)
+        if(const int64_t n = max - j; n > 0)
         {
-          out[j] = record[k];
-          k++;
+          state.audio.read(i, k, out.data() + j, n);
+          j += n;
+          k += n;
         }
 
         //if(state.quantif == 0.f)
@@ -422,10 +403,10 @@ struct Node
           k = 0;
 
           // TODO refactor sound_reader so that we can use it to have the proper repeated loop behaviour here...
-          for(; j < std::min(N, chan_samples); j++)
+          if(const int64_t n = std::min(N, chan_samples) - j; n > 0)
           {
-            out[j] = record[k];
-            k++;
+            state.audio.read(i, k, out.data() + j, n);
+            k += n;
           }
         }
 
@@ -500,24 +481,22 @@ struct Node
     p2.set_channels(chans);
     state.set_channels(chans);
 
+    const int64_t fit = chans > 0 ? state.grow(p1.channel(0).size()) : 0;
+
     for(std::size_t i = 0; i < chans; i++)
     {
       auto& in = p1.channel(i);
       auto& out = p2.channel(i);
-      auto& record = state.audio[i];
 
       const int64_t samples = in.size();
       int64_t max = std::min(N, samples);
 
       out.resize(samples);
-      record.resize(state.playbackPos + samples);
-      int64_t k = state.playbackPos;
-
-      for(int64_t j = first_pos; j < max; j++)
+      if(const int64_t n = max - first_pos; n > 0)
       {
-        out[j] = in[j];
-        record[k] = in[j];
-        k++;
+        std::copy_n(in.data() + first_pos, n, out.data() + first_pos);
+        if(const int64_t w = std::min(n, fit); w > 0)
+          state.audio.write(i, state.playbackPos, in.data() + first_pos, w);
       }
     }
     state.playbackPos += N;
@@ -532,22 +511,17 @@ struct Node
     p2.set_channels(chans);
     state.set_channels(chans);
 
+    const int64_t fit = chans > 0 ? state.grow(p1.channel(0).size()) : 0;
+
     for(std::size_t i = 0; i < chans; i++)
     {
       auto& in = p1.channel(i);
-      auto& record = state.audio[i];
 
       const int64_t samples = in.size();
       int64_t max = std::min(N, samples);
 
-      record.resize(state.playbackPos + samples);
-      int64_t k = state.playbackPos;
-
-      for(int64_t j = first_pos; j < max; j++)
-      {
-        record[k] = in[j];
-        k++;
-      }
+      if(const int64_t n = std::min(max - first_pos, fit); n > 0)
+        state.audio.write(i, state.playbackPos, in.data() + first_pos, n);
     }
     state.playbackPos += N;
   }
@@ -568,8 +542,7 @@ struct Node
     {
       auto& in = p1.channel(i);
       auto& out = p2.channel(i);
-      auto& record = state.audio[i];
-      const int64_t record_samples = record.size();
+      const int64_t record_samples = state.audio.size();
 
       const int64_t samples = in.size();
       int64_t max = std::min(N, samples);
@@ -582,8 +555,9 @@ struct Node
         if(k >= record_samples)
           k = 0;
 
-        record[k] += in[j];
-        out[j] = record[k];
+        float& record = state.audio.sample(i, k);
+        record += in[j];
+        out[j] = record;
 
         k++;
       }
@@ -607,8 +581,7 @@ struct Node
     {
       auto& in = p1.channel(i);
       auto& out = p2.channel(i);
-      auto& record = state.audio[i];
-      const int64_t record_samples = record.size();
+      const int64_t record_samples = state.audio.size();
 
       const int64_t samples = in.size();
       int64_t max = std::min(N, samples);
@@ -621,8 +594,9 @@ struct Node
         if(k >= record_samples)
           k = 0;
 
-        out[j] = record[k];
-        record[k] += in[j];
+        float& record = state.audio.sample(i, k);
+        out[j] = record;
+        record += in[j];
 
         k++;
       }
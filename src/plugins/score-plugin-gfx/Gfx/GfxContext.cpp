@@ -242,6 +242,7 @@ void GfxContext::update_inputs()
     if(msg.input.capacity() > 0)
       m_buffers.release(std::move(msg).input);
   }
+  m_inputUpdates.fetch_add(1, std::memory_order_release);
 
   for(auto& n : nodes)
   {
@@ -13,6 +13,8 @@
 
 #include <concurrentqueue.h>
 #include <score_plugin_gfx_export.h>
+
+#include <atomic>
 namespace score::gfx
 {
 struct Graph;
@@ -57,6 +59,12 @@ public:
     tick_messages.enqueue(std::move(msg));
   }
 
+  //! Incremented each time the render thread took the messages sent so far
+  int64_t input_updates() const noexcept
+  {
+    return m_inputUpdates.load(std::memory_order_acquire);
+  }
+
 private:
   void run_commands();
   void add_preview_output(score::gfx::OutputNode& out);
@@ -100,6 +108,7 @@ private:
   using Command = ossia::variant<NodeCommand, EdgeCommand>;
   moodycamel::ConcurrentQueue<Command> tick_commands;
   moodycamel::ConcurrentQueue<score::gfx::Message> tick_messages;
+  std::atomic_int64_t m_inputUpdates{};
 
   std::mutex edges_lock;
   ossia::flat_set<Edge> new_edges TS_GUARDED_BY(edges_lock);
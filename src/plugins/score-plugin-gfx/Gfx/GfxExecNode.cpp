@@ -91,7 +91,9 @@ void gfx_exec_node::run(
             // FIXME If the cables, or address have changed
             // We likely want to reload the geometry in any case
             // .. or do we?
-            msg.input[inlet_i] = p.meshes;
+            // The producer may write to its meshes while they are rendered
+            msg.input[inlet_i] = m_meshes[inlet].update(
+                p.meshes, exec_context->ui->input_updates());
           }
           //if(p.flags & ossia::geometry_port::dirty_transform)
           {
@@ -7,10 +7,12 @@
 #include <Gfx/GfxContext.hpp>
 #include <Gfx/GfxDevice.hpp>
 #include <Gfx/GfxExecContext.hpp>
+#include <Gfx/MeshSnapshot.hpp>
 
 #include <ossia/dataflow/graph_edge.hpp>
 #include <ossia/dataflow/graph_node.hpp>
 #include <ossia/dataflow/port.hpp>
+#include <ossia/detail/hash_map.hpp>
 
 #include <score_plugin_gfx_export.h>
 
@@ -107,6 +109,9 @@ public:
   std::atomic_int32_t script_index{0};
   ossia::time_value m_last_flicks{};
   void run(const ossia::token_request& tk, ossia::exec_state_facade) noexcept override;
+
+private:
+  ossia::hash_map<const ossia::inlet*, mesh_snapshot> m_meshes;
 };
 
 struct SCORE_PLUGIN_GFX_EXPORT con_unvalidated
@@ -20,6 +20,19 @@ class CustomMesh : public score::gfx::Mesh
   ossia::small_vector<QRhiVertexInputBinding, 2> vertexBindings;
   ossia::small_vector<QRhiVertexInputAttribute, 2> vertexAttributes;
 
+  // Vertex and index data last uploaded
+  mutable const void* m_uploaded[2]{};
+
+  // GPU buffers only grow, with some headroom for geometry which keeps growing
+  static void reserve(QRhiBuffer& buf, int64_t size)
+  {
+    if(size <= buf.size())
+      return;
+    buf.destroy();
+    buf.setSize(size + size / 2);
+    buf.create();
+  }
+
 public:
   int64_t dirtyGeometryIndex{-1};
   explicit CustomMesh(const ossia::mesh_list& g) { reload(g); }
@@ -55,50 +68,37 @@ public:
 
   void update(MeshBuffers& meshbuf, QRhiResourceUpdateBatch& rb) const noexcept override
   {
-    if(geom.meshes.empty())
-      return;
-    if(geom.meshes[0].buffers.empty())
+    // The buffers which did not change are shared with the previous geometry,
+    // which geom keeps alive until then: they are not uploaded again.
+    if(!meshbuf.mesh || geom.meshes.empty() || geom.meshes[0].buffers.empty())
+    {
+      m_uploaded[0] = m_uploaded[1] = nullptr;
       return;
+    }
 
-    void* idx_buf_data = nullptr;
-    const auto vtx_buf = geom.meshes[0].buffers[0];
-    if(auto sz = vtx_buf.size; sz != meshbuf.mesh->size())
+    const auto& buffers = geom.meshes[0].buffers;
+    if(const auto& vtx_buf = buffers[0];
+       vtx_buf.size > 0 && vtx_buf.data.get() != m_uploaded[0])
     {
-      meshbuf.mesh->destroy();
-      meshbuf.mesh->setSize(sz);
-      meshbuf.mesh->create();
+      reserve(*meshbuf.mesh, vtx_buf.size);
+      rb.updateDynamicBuffer(meshbuf.mesh, 0, vtx_buf.size, vtx_buf.data.get());
+      m_uploaded[0] = vtx_buf.data.get();
     }
 
-    if(meshbuf.index)
+    // FIXME what if index appears or disappears
+    if(!meshbuf.index || buffers.size() < 2)
     {
-      const auto idx_buf = geom.meshes[0].buffers[1];
-      if(geom.meshes[0].buffers.size() > 1)
-      {
-        if(const auto idx_buf_size = idx_buf.size; idx_buf_size > 0)
-        {
-          idx_buf_data = idx_buf.data.get();
-          // FIXME what if index disappears
-          if(auto sz = idx_buf.size; sz != meshbuf.index->size())
-          {
-            meshbuf.index->destroy();
-            meshbuf.index->setSize(sz);
-            meshbuf.index->create();
-          }
-          else
-          {
-          }
-        }
-      }
+      m_uploaded[1] = nullptr;
     }
     else
     {
-      // FIXME what if index appears
-    }
-
-    rb.updateDynamicBuffer(meshbuf.mesh, 0, meshbuf.mesh->size(), vtx_buf.data.get());
-    if(meshbuf.index)
-    {
-      rb.updateDynamicBuffer(meshbuf.index, 0, meshbuf.index->size(), idx_buf_data);
+      const auto& idx_buf = buffers[1];
+      if(idx_buf.size > 0 && idx_buf.data.get() != m_uploaded[1])
+      {
+        reserve(*meshbuf.index, idx_buf.size);
+        rb.updateDynamicBuffer(meshbuf.index, 0, idx_buf.size, idx_buf.data.get());
+        m_uploaded[1] = idx_buf.data.get();
+      }
     }
   }
 
@@ -154,6 +154,7 @@ ImagesNode::ImagesNode()
   output.push_back(new Port{this, {}, Types::Image, {}});
 
   m_materialData.reset((char*)&ubo);
+  changeTracking = true;
 }
 
 void ImagesNode::process(Message&& msg)
@@ -174,10 +175,10 @@ void ImagesNode::process(Message&& msg)
               [this, sink](const auto& v) { ProcessNode::process(sink.port, v); },
               std::move(m));
 
-          if(linearImages.size() > 0)
+          if(sequence && sequence->size() > 0)
           {
-            const int idx = imageIndex(ubo.currentImageIndex, linearImages.size());
-            auto sz = linearImages[idx]->size();
+            const int idx = imageIndex(ubo.currentImageIndex, sequence->size());
+            auto sz = sequence->frame(idx).size;
             ubo.imageSize[0] = sz.width();
             ubo.imageSize[1] = sz.height();
           }
@@ -222,26 +223,27 @@ void ImagesNode::process(Message&& msg)
         case 5: // Images
         {
           {
-            linearImages.clear();
             Gfx::releaseImages(images);
             images = Gfx::getImages(*val);
+
+            std::vector<ImageSequence::Frame> frames;
             for(auto& img : images)
-            {
-              for(auto& frame : img.frames)
-              {
-                linearImages.push_back(&frame);
-              }
-            }
+              for(int i = 0; i < std::ssize(img.frames); i++)
+                frames.push_back({img.path, i, img.frames[i]});
 
-            if(linearImages.size() > 0)
+            sequence = std::make_unique<ImageSequence>(std::move(frames));
+            sequence->setOnReady([this] { markChanged(); });
+
+            if(sequence->size() > 0)
             {
-              const int idx = imageIndex(ubo.currentImageIndex, linearImages.size());
-              auto sz = linearImages[idx]->size();
+              const int idx = imageIndex(ubo.currentImageIndex, sequence->size());
+              auto sz = sequence->frame(idx).size;
               ubo.imageSize[0] = sz.width();
               ubo.imageSize[1] = sz.height();
             }
 
             ++this->imagesChanged;
+            this->markChanged();
           }
           break;
         }
@@ -294,13 +296,20 @@ static QRhiSampler* createSampler(ImageMode tile, QRhi& rhi)
   sampler->create();
   return sampler;
 }
-class ImagesNode::PreloadedRenderer : public GenericNodeRenderer
+/**
+ * Small sequences get one texture per frame, uploaded the first time the frame
+ * is displayed: once played they stay on the GPU.
+ * The frames of the other sequences are streamed to a single texture.
+ */
+class ImagesNode::Renderer : public GenericNodeRenderer
 {
 public:
   using GenericNodeRenderer::GenericNodeRenderer;
 
 private:
-  ~PreloadedRenderer() { }
+  ~Renderer() { }
+
+  static constexpr int64_t resident_bytes = 256 * 1024 * 1024;
 
   int imagesChanged = -1;
   ImageMode tile{};
@@ -309,21 +318,58 @@ private:
   {
     auto& n = static_cast<const ImagesNode&>(this->node);
 
-    const int limits_min = rhi.resourceLimit(QRhi::ResourceLimit::TextureSizeMin);
-    const int limits_max = rhi.resourceLimit(QRhi::ResourceLimit::TextureSizeMax);
+    for(auto tex : m_textures)
+      tex->deleteLater();
+    m_textures.clear();
+    m_textureFrames.clear();
 
-    for(const QImage* frame : n.linearImages)
+    if(!n.sequence || n.sequence->size() == 0)
+      return;
+
+    auto& seq = *n.sequence;
+    seq.setSizeLimits(
+        rhi.resourceLimit(QRhi::ResourceLimit::TextureSizeMin),
+        rhi.resourceLimit(QRhi::ResourceLimit::TextureSizeMax));
+
+    std::vector<QSize> sizes;
+    sizes.reserve(seq.size());
+    QSize maxSize{1, 1};
+    int64_t bytes = 0;
+    for(int i = 0; i < seq.size(); i++)
     {
-      const QSize sz = frame->size();
-      auto tex = rhi.newTexture(
-          QRhiTexture::BGRA8,
-          resizeTextureSize(QSize{sz.width(), sz.height()}, limits_min, limits_max), 1,
-          QRhiTexture::Flag{});
+      const QSize sz = seq.textureSize(i);
+      sizes.push_back(sz);
+      maxSize = maxSize.expandedTo(sz);
+      bytes += 4 * int64_t(sz.width()) * sz.height();
+    }
+
+    if(bytes > resident_bytes)
+      sizes = {maxSize};
 
+    for(QSize sz : sizes)
+    {
+      auto tex = rhi.newTexture(QRhiTexture::BGRA8, sz, 1, QRhiTexture::Flag{});
       tex->setName("ImagesNode::tex");
       tex->create();
       m_textures.push_back(tex);
     }
+    m_textureFrames.assign(m_textures.size(), -1);
+  }
+
+  void setTexture(QRhiTexture* tex)
+  {
+    auto& [sampler, cur] = m_samplers[0];
+    if(cur == tex)
+      return;
+
+    auto replace_texture = [](PassMap& passes, QRhiSampler* sampler, QRhiTexture* tex) {
+      for(auto& pass : passes)
+        score::gfx::replaceTexture(*pass.second.srb, sampler, tex);
+    };
+
+    replace_texture(m_p, sampler, tex);
+    replace_texture(m_altPasses, sampler, tex);
+    cur = tex;
   }
 
   TextureRenderTarget renderTargetForInput(const Port& p) override { return {}; }
@@ -336,10 +382,9 @@ private:
     processUBOInit(renderer);
     m_material.init(renderer, node.input, m_samplers);
 
-    m_prev_ubo.currentImageIndex = -1;
     QRhi& rhi = *renderer.state.rhi;
 
-    // Create GPU textures for each image
+    imagesChanged = n.imagesChanged;
     recreateTextures(rhi);
 
     tile = n.tile;
@@ -351,11 +396,11 @@ private:
       std::tie(v, f) = score::gfx::makeShaders(
           rs, TexturedTriangle{}.defaultVertexShader(), images_tiled_fragment_shader);
 
-    // Create the sampler in which we are going to put the texture
+    // Create the sampler in which we are going to put the texture.
+    // Nothing is shown until the first frame is decoded.
     {
       auto sampler = createSampler(tile, rhi);
-      auto tex = m_textures.empty() ? &renderer.emptyTexture() : m_textures.front();
-      m_samplers.push_back({sampler, tex});
+      m_samplers.push_back({sampler, &renderer.emptyTexture()});
     }
 
     // Initialize the passes for the "single" case
@@ -406,59 +451,30 @@ private:
       s->deleteLater();
     }
 
-    bool updateCurrentTexture = false;
     if(n.imagesChanged > imagesChanged)
     {
       imagesChanged = n.imagesChanged;
-      for(auto tex : m_textures)
-      {
-        tex->deleteLater();
-      }
-      m_textures.clear();
-
+      setTexture(&renderer.emptyTexture());
       recreateTextures(*renderer.state.rhi);
-      m_uploaded = false;
-    }
-
-    // If images haven't been uploaded yet, upload them.
-    if(!m_uploaded)
-    {
-      std::size_t k = 0;
-      for(const QImage* frame : n.linearImages)
-      {
-        res.uploadTexture(m_textures[k], renderer.adaptImage(*frame));
-        k++;
-      }
-      m_uploaded = true;
-      updateCurrentTexture = true;
     }
 
-    // If the current image being displayed by this renderer (in m_prev_ubo)
-    // is out of date with the image in the data model, we switch the texture
-    if(updateCurrentTexture || m_prev_ubo.currentImageIndex != n.ubo.currentImageIndex)
+    // Until the current frame is decoded, the previous one stays displayed
+    if(n.sequence && !m_textures.empty())
     {
-      auto replace_texture
-          = [](PassMap& passes, QRhiSampler* sampler, QRhiTexture* tex) {
-        for(auto& pass : passes)
-          score::gfx::replaceTexture(*pass.second.srb, sampler, tex);
-      };
-
-      const int idx = imageIndex(n.ubo.currentImageIndex, m_textures.size());
-      QRhiSampler* sampler = m_samplers[0].sampler;
-      QRhiTexture* new_tex{};
-      if(ossia::valid_index(idx, m_textures))
+      auto& seq = *n.sequence;
+      const int idx = imageIndex(n.ubo.currentImageIndex, seq.size());
+      const int slot = m_textures.size() == 1 ? 0 : idx;
+      if(m_textureFrames[slot] != idx)
       {
-        new_tex = m_textures[idx];
-      }
-      else
-      {
-        new_tex = &renderer.emptyTexture();
+        if(QImage img = seq.request(idx); !img.isNull())
+        {
+          res.uploadTexture(m_textures[slot], img);
+          m_textureFrames[slot] = idx;
+        }
       }
 
-      replace_texture(m_p, sampler, new_tex);
-      replace_texture(m_altPasses, sampler, new_tex);
-
-      m_prev_ubo.currentImageIndex = n.ubo.currentImageIndex;
+      if(m_textureFrames[slot] == idx)
+        setTexture(m_textures[slot]);
     }
 
     GenericNodeRenderer::update(renderer, res);
@@ -480,6 +496,7 @@ private:
       tex->deleteLater();
     }
     m_textures.clear();
+    m_textureFrames.clear();
 
     defaultRelease(r);
 
@@ -490,199 +507,16 @@ private:
     }
   }
 
-  struct ImagesNode::UBO m_prev_ubo;
   ossia::small_vector<std::pair<Edge*, Pipeline>, 2> m_altPasses;
   std::vector<QRhiTexture*> m_textures;
-  bool m_uploaded = false;
-};
-
-class ImagesNode::OnTheFlyRenderer : public GenericNodeRenderer
-{
-public:
-  using GenericNodeRenderer::GenericNodeRenderer;
-
-private:
-  ~OnTheFlyRenderer() { }
 
-  int imagesChanged = -1;
-  ImageMode tile{};
-
-  void recreateTexture(QRhi& rhi)
-  {
-    auto& n = static_cast<const ImagesNode&>(this->node);
-
-    const int limits_min = rhi.resourceLimit(QRhi::ResourceLimit::TextureSizeMin);
-    const int limits_max = rhi.resourceLimit(QRhi::ResourceLimit::TextureSizeMax);
-
-    QSize maxSize{1, 1};
-    for(const QImage* frame : n.linearImages)
-    {
-      const auto sz = resizeTextureSize(frame->size(), limits_min, limits_max);
-
-      maxSize.setWidth(std::max(maxSize.width(), sz.width()));
-      maxSize.setHeight(std::max(maxSize.height(), sz.height()));
-    }
-
-    auto tex = rhi.newTexture(QRhiTexture::BGRA8, maxSize, 1, QRhiTexture::Flag{});
-
-    tex->setName("OnTheFlyRenderer::tex");
-    tex->create();
-
-    m_texture = tex;
-  }
-
-  TextureRenderTarget renderTargetForInput(const Port& p) override { return {}; }
-  void init(RenderList& renderer, QRhiResourceUpdateBatch& res) override
-  {
-    auto& n = static_cast<const ImagesNode&>(this->node);
-    const auto& rs = renderer.state;
-    const auto& mesh = renderer.defaultQuad();
-    defaultMeshInit(renderer, mesh, res);
-    processUBOInit(renderer);
-    m_material.init(renderer, node.input, m_samplers);
-
-    m_prev_ubo.currentImageIndex = -1;
-    QRhi& rhi = *renderer.state.rhi;
-
-    tile = n.tile;
-    QShader &v = m_vertexS, &f = m_fragmentS;
-    if(!tile)
-      std::tie(v, f) = score::gfx::makeShaders(
-          rs, images_single_vertex_shader, images_single_fragment_shader);
-    else
-      std::tie(v, f) = score::gfx::makeShaders(
-          rs, TexturedTriangle{}.defaultVertexShader(), images_tiled_fragment_shader);
-
-    // Create the sampler in which we are going to put the texture
-    {
-      auto sampler = createSampler(tile, rhi);
-
-      // Create GPU texture
-      recreateTexture(rhi);
-
-      m_samplers.push_back({sampler, m_texture});
-    }
-
-    // Initialize the passes for the "single" case
-    defaultPassesInit(renderer, mesh);
-
-    // Initialize the passes for the "tiled" case
-    {
-      auto [v, f] = score::gfx::makeShaders(
-          rs, TexturedTriangle{}.defaultVertexShader(), images_tiled_fragment_shader);
-      for(Edge* edge : this->node.output[0]->edges)
-      {
-        auto rt = renderer.renderTargetForOutput(*edge);
-        if(rt.renderTarget)
-        {
-          m_altPasses.emplace_back(
-              edge, score::gfx::buildPipeline(
-                        renderer, mesh, v, f, rt, m_processUBO, m_material.buffer,
-                        m_samplers));
-        }
-      }
-    }
-  }
-
-  void update(RenderList& renderer, QRhiResourceUpdateBatch& res) override
-  {
-    auto& n = static_cast<const ImagesNode&>(this->node);
-
-    if(n.tile != tile)
-    {
-      tile = n.tile;
-      auto [s, tex] = m_samplers[0];
-
-      m_samplers.clear();
-
-      // Create a new sampler
-      auto new_sampler = createSampler(tile, *renderer.state.rhi);
-      m_samplers.push_back({new_sampler, tex});
-
-      // Replace it in the render passes
-      auto replace_sampler = [](PassMap& passes, QRhiSampler* oldS, QRhiSampler* newS) {
-        for(auto& pass : passes)
-          score::gfx::replaceSampler(*pass.second.srb, oldS, newS);
-      };
-
-      replace_sampler(m_p, s, new_sampler);
-      replace_sampler(m_altPasses, s, new_sampler);
-
-      // Release the old sampler
-      s->deleteLater();
-    }
-
-    if(n.imagesChanged > imagesChanged)
-    {
-      imagesChanged = n.imagesChanged;
-      m_texture->deleteLater();
-      m_texture = nullptr;
-
-      recreateTexture(*renderer.state.rhi);
-      m_uploaded = false;
-
-      auto replace_texture
-          = [](PassMap& passes, QRhiSampler* sampler, QRhiTexture* tex) {
-        for(auto& pass : passes)
-          score::gfx::replaceTexture(*pass.second.srb, sampler, tex);
-      };
-
-      auto sampler = m_samplers[0].sampler;
-      replace_texture(m_p, sampler, m_texture);
-      replace_texture(m_altPasses, sampler, m_texture);
-    }
-
-    // If the current image being displayed by this renderer (in m_prev_ubo)
-    // is out of date with the image in the data model, we switch the texture
-    if(!m_uploaded || m_prev_ubo.currentImageIndex != n.ubo.currentImageIndex)
-    {
-      const int idx = imageIndex(n.ubo.currentImageIndex, n.linearImages.size());
-      if(ossia::valid_index(idx, n.linearImages))
-      {
-        auto frame = n.linearImages[idx];
-
-        res.uploadTexture(m_texture, renderer.adaptImage(*frame));
-
-        m_prev_ubo.currentImageIndex = n.ubo.currentImageIndex;
-        m_uploaded = true;
-      }
-    }
-
-    GenericNodeRenderer::update(renderer, res);
-  }
-
-  void runRenderPass(RenderList& renderer, QRhiCommandBuffer& cb, Edge& edge) override
-  {
-    const auto& mesh = renderer.defaultQuad();
-    if(tile == ImageMode::Single)
-      defaultRenderPass(renderer, mesh, cb, edge, m_p);
-    else
-      defaultRenderPass(renderer, mesh, cb, edge, m_altPasses);
-  }
-
-  void release(RenderList& r) override
-  {
-    m_texture->deleteLater();
-    m_texture = nullptr;
-
-    defaultRelease(r);
-
-    {
-      for(auto& pass : m_altPasses)
-        pass.second.release();
-      m_altPasses.clear();
-    }
-  }
-
-  struct ImagesNode::UBO m_prev_ubo;
-  ossia::small_vector<std::pair<Edge*, Pipeline>, 2> m_altPasses;
-  QRhiTexture* m_texture{};
-  bool m_uploaded = false;
+  // Frame currently in each texture
+  std::vector<int> m_textureFrames;
 };
 
 NodeRenderer* ImagesNode::createRenderer(RenderList& r) const noexcept
 {
-  return new PreloadedRenderer{*this};
+  return new Renderer{*this};
 }
 
 }
@@ -733,6 +567,7 @@ FullScreenImageNode::FullScreenImageNode(QImage dec)
     : m_image{std::move(dec)}
 {
   output.push_back(new Port{this, {}, Types::Image, {}});
+  changeTracking = true;
 }
 
 FullScreenImageNode::~FullScreenImageNode() { }
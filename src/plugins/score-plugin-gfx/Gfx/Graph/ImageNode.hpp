@@ -1,5 +1,6 @@
 #pragma once
 
+#include <Gfx/Graph/ImageSequence.hpp>
 #include <Gfx/Graph/Node.hpp>
 
 namespace score::gfx
@@ -23,8 +24,7 @@ public:
 
   score::gfx::NodeRenderer* createRenderer(RenderList& r) const noexcept override;
 
-  class PreloadedRenderer;
-  class OnTheFlyRenderer;
+  class Renderer;
 
 #pragma pack(push, 1)
   struct UBO
@@ -44,7 +44,7 @@ private:
   void process(Message&& msg) override;
 
   std::vector<score::gfx::Image> images;
-  std::vector<QImage*> linearImages;
+  std::unique_ptr<ImageSequence> sequence;
 };
 struct FullScreenImageNode : NodeModel
 {
@@ -0,0 +1,258 @@
+#include "ImageSequence.hpp"
+
+#include <Gfx/Graph/Utils.hpp>
+
+#include <score/tools/ThreadPool.hpp>
+
+#include <ossia/detail/hash_map.hpp>
+
+#include <QDebug>
+#include <QImageReader>
+
+#include <mutex>
+#include <optional>
+
+namespace score::gfx
+{
+// Formats which cannot jump to a frame, e.g. GIF, are read from their first
+// frame: a reader is kept per file to go on from the last frame read.
+struct SequentialReader
+{
+  std::mutex mutex;
+  std::optional<QImageReader> reader;
+  int next{};
+};
+
+struct ImageSequence::State
+{
+  std::mutex mutex;
+  ossia::hash_map<int, QImage> cache;
+  ossia::hash_set<int> pending;
+  ossia::hash_set<int> failed;
+  int64_t cachedBytes{};
+
+  int frames{};
+  int current{};
+  int direction{1};
+  int missing{-1};
+
+  int minSize{1};
+  int maxSize{16384};
+
+  ossia::hash_map<QString, std::shared_ptr<SequentialReader>> readers;
+
+  // Incremented when the decoded frames become invalid
+  int64_t generation{};
+  std::function<void()> onReady;
+
+  // Position of a frame after the current one in the direction of playback
+  int distance(int idx) const noexcept
+  {
+    return ((idx - current) * direction % frames + frames) % frames;
+  }
+
+  bool wanted(int idx) const noexcept { return distance(idx) <= lookahead; }
+
+  // Drops the frames farthest from the current one until the cache fits
+  void evict()
+  {
+    while(cachedBytes > cache_bytes && !cache.empty())
+    {
+      auto farthest = cache.begin();
+      for(auto it = cache.begin(); it != cache.end(); ++it)
+        if(distance(it->first) > distance(farthest->first))
+          farthest = it;
+
+      if(farthest->first == current)
+        break;
+
+      cachedBytes -= farthest->second.sizeInBytes();
+      cache.erase(farthest);
+    }
+  }
+
+  std::shared_ptr<SequentialReader> sequentialReader(const QString& path)
+  {
+    std::lock_guard lck{mutex};
+    auto& r = readers[path];
+    if(!r)
+      r = std::make_shared<SequentialReader>();
+    return r;
+  }
+};
+
+static QImage readFrame(QImageReader& reader, QSize size, int min, int max)
+{
+  // Some formats, e.g. JPEG, are cheaper to decode directly at a smaller size
+  const QSize target = resizeTextureSize(size, min, max);
+  if(target != size && reader.supportsOption(QImageIOHandler::ScaledSize))
+    reader.setScaledSize(target);
+
+  QImage img = reader.read();
+  if(img.isNull())
+    return {};
+
+  img = resizeTexture(img, min, max);
+  if(img.format() != QImage::Format_ARGB32)
+    img.convertTo(QImage::Format_ARGB32);
+  return img;
+}
+
+template <typename GetReader>
+static QImage
+decodeFrame(const ImageSequence::Frame& f, int min, int max, GetReader sequentialReader)
+{
+  {
+    QImageReader reader{f.path};
+    reader.setBackgroundColor(Qt::transparent);
+    if(f.index == 0 || reader.jumpToImage(f.index))
+      return readFrame(reader, f.size, min, max);
+  }
+
+  // Playing forward reads each frame once; going back opens the file again
+  auto seq = sequentialReader();
+  std::lock_guard lck{seq->mutex};
+  if(!seq->reader || seq->next > f.index)
+  {
+    seq->reader.emplace(f.path);
+    seq->reader->setBackgroundColor(Qt::transparent);
+    seq->next = 0;
+  }
+
+  auto& reader = *seq->reader;
+  for(; seq->next < f.index; seq->next++)
+  {
+    if(!reader.canRead() || (!reader.jumpToNextImage() && reader.read().isNull()))
+    {
+      seq->reader.reset();
+      return {};
+    }
+  }
+
+  QImage img = readFrame(reader, f.size, min, max);
+  if(img.isNull())
+    seq->reader.reset();
+  else
+    seq->next++;
+  return img;
+}
+
+ImageSequence::ImageSequence(std::vector<Frame> frames)
+    : m_frames{std::move(frames)}
+    , m_state{std::make_shared<State>()}
+{
+  m_state->frames = std::ssize(m_frames);
+}
+
+ImageSequence::~ImageSequence()
+{
+  std::lock_guard lck{m_state->mutex};
+  m_state->generation++;
+  m_state->onReady = {};
+  m_state->cache.clear();
+  m_state->cachedBytes = 0;
+}
+
+QSize ImageSequence::textureSize(int idx) const noexcept
+{
+  std::lock_guard lck{m_state->mutex};
+  return resizeTextureSize(m_frames[idx].size, m_state->minSize, m_state->maxSize);
+}
+
+void ImageSequence::setSizeLimits(int min, int max)
+{
+  auto& s = *m_state;
+  std::lock_guard lck{s.mutex};
+  min = std::max(min, s.minSize);
+  max = std::min(max, s.maxSize);
+  if(min == s.minSize && max == s.maxSize)
+    return;
+
+  s.minSize = min;
+  s.maxSize = max;
+  s.generation++;
+  s.cache.clear();
+  s.cachedBytes = 0;
+}
+
+void ImageSequence::setOnReady(std::function<void()> f)
+{
+  std::lock_guard lck{m_state->mutex};
+  m_state->onReady = std::move(f);
+}
+
+QImage ImageSequence::request(int idx)
+{
+  auto& s = *m_state;
+  if(s.frames == 0)
+    return {};
+
+  std::lock_guard lck{s.mutex};
+  if(idx != s.current)
+  {
+    // Looping around counts as going forward
+    const int forward = ((idx - s.current) % s.frames + s.frames) % s.frames;
+    s.direction = forward <= s.frames - forward ? 1 : -1;
+    s.current = idx;
+  }
+
+  for(int k = 0; k <= lookahead; k++)
+  {
+    const int next = ((idx + k * s.direction) % s.frames + s.frames) % s.frames;
+    if(s.cache.find(next) != s.cache.end()
+       || s.pending.find(next) != s.pending.end()
+       || s.failed.find(next) != s.failed.end())
+      continue;
+
+    s.pending.insert(next);
+    score::TaskPool::instance().post(
+        [state = m_state, next, frame = m_frames[next], generation = s.generation,
+         min = s.minSize, max = s.maxSize] {
+      {
+        // Skip the frames which were scrubbed past in the meantime
+        std::lock_guard lck{state->mutex};
+        if(generation != state->generation || !state->wanted(next))
+        {
+          state->pending.erase(next);
+          return;
+        }
+      }
+
+      QImage img = decodeFrame(
+          frame, min, max, [&] { return state->sequentialReader(frame.path); });
+      if(img.isNull())
+        qDebug() << "Could not decode " << frame.path << frame.index;
+
+      std::lock_guard lck{state->mutex};
+      state->pending.erase(next);
+      if(img.isNull())
+      {
+        // Not retried: the file would fail the same way on every frame
+        state->failed.insert(next);
+        return;
+      }
+
+      // If the size limits changed, the renderer asks again for the frame
+      if(generation == state->generation)
+      {
+        state->cachedBytes += img.sizeInBytes();
+        state->cache[next] = std::move(img);
+        state->evict();
+      }
+
+      if(next == state->missing)
+      {
+        state->missing = -1;
+        if(state->onReady)
+          state->onReady();
+      }
+    }, k == 0 ? score::TaskPool::Priority::High : score::TaskPool::Priority::Normal);
+  }
+
+  if(auto it = s.cache.find(idx); it != s.cache.end())
+    return it->second;
+
+  s.missing = idx;
+  return {};
+}
+}
@@ -0,0 +1,68 @@
+#pragma once
+#include <QImage>
+#include <QSize>
+#include <QString>
+
+#include <score_plugin_gfx_export.h>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace score::gfx
+{
+/**
+ * @brief Streams the frames of a list of image files.
+ *
+ * Frames are decoded on the task pool, a few frames ahead of the one being
+ * displayed in the direction of playback, and scaled down to the texture size
+ * limits of the GPU there: the render thread only uploads them.
+ * The decoded frames are kept in a cache bounded by cache_bytes.
+ *
+ * Thread-safe: the decoding tasks keep the shared state alive after the
+ * sequence is destroyed and drop their results.
+ */
+class SCORE_PLUGIN_GFX_EXPORT ImageSequence
+{
+public:
+  struct Frame
+  {
+    QString path;
+    int index{}; //!< Index of the frame in the file, e.g. for GIFs
+    QSize size;  //!< Size in the file
+  };
+
+  static constexpr int lookahead = 8;
+  static constexpr int64_t cache_bytes = 512 * 1024 * 1024;
+
+  explicit ImageSequence(std::vector<Frame> frames);
+  ~ImageSequence();
+  ImageSequence(const ImageSequence&) = delete;
+  ImageSequence& operator=(const ImageSequence&) = delete;
+
+  int size() const noexcept { return std::ssize(m_frames); }
+  const Frame& frame(int idx) const noexcept { return m_frames[idx]; }
+
+  //! Size of a frame once decoded
+  QSize textureSize(int idx) const noexcept;
+
+  //! Restricts the size of the decoded frames, e.g. to the limits of a GPU
+  void setSizeLimits(int min, int max);
+
+  //! Called from a decoding thread when a frame which was missing is ready
+  void setOnReady(std::function<void()> f);
+
+  /**
+   * @brief Returns the frame if it is decoded, a null image otherwise.
+   *
+   * Never blocks: the decoding of the frame and of the ones which follow it
+   * is started if needed. Frames which failed to decode are not retried.
+   */
+  QImage request(int idx);
+
+private:
+  struct State;
+  std::vector<Frame> m_frames;
+  std::shared_ptr<State> m_state;
+};
+}
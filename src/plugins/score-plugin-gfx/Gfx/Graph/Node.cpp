@@ -317,12 +317,14 @@ void ProcessNode::process(int32_t port, const ossia::audio_vector& v)
         *sample = chan[i];
     }
   }
+  tex.version++;
+  markChanged();
 }
 
 void ProcessNode::process(int32_t port, const ossia::mesh_list_ptr& v)
 {
   this->geometry = v;
-  ++this->geometryChanged;
+  geometryChange();
 }
 
 void ProcessNode::process(int32_t port, const ossia::transform3d& v) { }
@@ -332,6 +334,7 @@ void ProcessNode::process(
 {
   SCORE_ASSERT(func);
   func(*this);
+  markChanged();
 }
 
 void ProcessNode::process(Message&& msg)
@@ -99,6 +99,22 @@ public:
    */
   ossia::flat_map<RenderList*, score::gfx::NodeRenderer*> renderedNodes;
 
+  /**
+   * @brief Notify the renderers that the rendering of this node changed.
+   */
+  void markChanged() noexcept { changes.fetch_add(1, std::memory_order_release); }
+  std::atomic_int64_t changes{0};
+
+  /**
+   * @brief Set by nodes whose rendering only changes through markChanged.
+   *
+   * The render passes drawing only such nodes, and whose inputs did not
+   * change either, are skipped: the render target keeps the previous frame.
+   * Nodes which change over time on their own (videos, shaders using the
+   * time...) must leave it unset.
+   */
+  bool changeTracking{};
+
   bool addedToGraph{};
 };
 
@@ -116,6 +132,7 @@ public:
   void materialChange() noexcept
   {
     materialChanged.fetch_add(1, std::memory_order_release);
+    markChanged();
   }
   bool hasMaterialChanged(int64_t& renderer) const noexcept
   {
@@ -135,6 +152,7 @@ public:
   void geometryChange() noexcept
   {
     geometryChanged.fetch_add(1, std::memory_order_release);
+    markChanged();
   }
   bool hasGeometryChanged(int64_t& renderer) const noexcept
   {
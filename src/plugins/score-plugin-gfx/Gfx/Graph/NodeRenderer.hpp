@@ -30,6 +30,12 @@ public:
   virtual void runRenderPass(RenderList&, QRhiCommandBuffer& commands, Edge& edge);
 
   virtual void release(RenderList&) = 0;
+
+  //! Change tracking state for RenderList::render, see Node::changeTracking.
+  //! Version of Node::changes rendered the last time.
+  int64_t renderedChanges{-1};
+  //! Whether the output of this renderer changed in the current frame.
+  bool changedThisFrame{true};
 };
 
 using PassMap = ossia::small_vector<std::pair<Edge*, Pipeline>, 2>;
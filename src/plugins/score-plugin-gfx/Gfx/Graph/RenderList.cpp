@@ -117,6 +117,9 @@ void RenderList::release()
   }
 
   m_vertexBuffers.clear();
+
+  for(auto [node, mesh] : m_customMeshCache)
+    delete mesh;
   m_customMeshCache.clear();
 
   delete m_outputUBO;
@@ -158,6 +161,9 @@ void RenderList::maybeRebuild()
 
     m_lastSize = outputSize;
     m_built = true;
+
+    // The render targets are new: everything has to be drawn again
+    m_forceRender = true;
   }
 }
 
@@ -186,35 +192,33 @@ QImage RenderList::adaptImage(const QImage& frame)
 }
 
 RenderList::Buffers RenderList::acquireMesh(
-    const ossia::mesh_list_ptr& p, QRhiResourceUpdateBatch& res) noexcept
+    const Node& node, const ossia::mesh_list_ptr& p,
+    QRhiResourceUpdateBatch& res) noexcept
 {
-  if(auto it = m_customMeshCache.find(p); it != m_customMeshCache.end())
+  if(auto it = m_customMeshCache.find(&node); it != m_customMeshCache.end())
   {
-    auto m = const_cast<CustomMesh*>(safe_cast<const CustomMesh*>(it->second));
-
-    if(m)
+    auto m = it->second;
+    auto meshbufs_it = this->m_vertexBuffers.find(m);
+    SCORE_ASSERT(meshbufs_it != this->m_vertexBuffers.end());
+    auto& mb = meshbufs_it->second;
+
+    // The geometry is a copy made for the render thread, see Gfx::mesh_snapshot:
+    // it does not change while it is being uploaded
+    if(auto cur_idx = p->dirty_index; m->dirtyGeometryIndex != cur_idx)
     {
-      auto meshbufs_it = this->m_vertexBuffers.find(m);
-      SCORE_ASSERT(meshbufs_it != this->m_vertexBuffers.end());
-      auto mb = meshbufs_it->second;
-
-      // FIX the thraed-unsafety: basically, we need to
-      // have some level of double- or triple-buffering
-      if(auto cur_idx = p->dirty_index; m->dirtyGeometryIndex != cur_idx)
-      {
-        m->reload(*p);
-        m->update(mb, res);
-        m->dirtyGeometryIndex = cur_idx;
-      }
-
-      return {m, mb};
+      m->reload(*p);
+      m->update(mb, res);
+      m->dirtyGeometryIndex = cur_idx;
     }
+
+    return {m, mb};
   }
 
   auto m = new CustomMesh{*p};
+  m->dirtyGeometryIndex = p->dirty_index;
   auto meshbufs = initMeshBuffer(*m, res);
 
-  this->m_customMeshCache[p] = m;
+  this->m_customMeshCache[&node] = m;
   return {m, meshbufs};
 }
 
@@ -262,6 +266,20 @@ const Mesh& RenderList::defaultTriangle() const noexcept
   */
 }
 
+static bool hasChanged(const Node& node, NodeRenderer& renderer) noexcept
+{
+  if(!node.changeTracking)
+    return true;
+
+  const auto changes = node.changes.load(std::memory_order_acquire);
+  if(changes != renderer.renderedChanges)
+  {
+    renderer.renderedChanges = changes;
+    return true;
+  }
+  return false;
+}
+
 void RenderList::render(QRhiCommandBuffer& commands, bool force)
 {
   if(renderers.size() <= 1 && !force)
@@ -310,6 +328,12 @@ void RenderList::render(QRhiCommandBuffer& commands, bool force)
   for(auto it = this->nodes.rbegin(); it != this->nodes.rend(); ++it)
   {
     auto node = *it;
+    SCORE_ASSERT(node->renderedNodes.find(this) != node->renderedNodes.end());
+    NodeRenderer* nodeRenderer = node->renderedNodes.find(this)->second;
+
+    // The nodes are visited after all the nodes they depend on:
+    // a node changed if its state did, or if any of its inputs was re-rendered.
+    bool changed = hasChanged(*node, *nodeRenderer);
     for(auto input : node->input)
     {
       // For each edge incoming to each image input ports of this node,
@@ -319,7 +343,8 @@ void RenderList::render(QRhiCommandBuffer& commands, bool force)
         prevRenderers.clear();
         prevRenderers.reserve(input->edges.size());
 
-        // First update them all and store them in prevRenderers (saves a couple lookups)
+        // The output's render target is not kept across frames
+        bool inputChanged = m_forceRender || node == &output;
         for(auto edge : input->edges)
         {
           auto src = edge->source;
@@ -329,7 +354,21 @@ void RenderList::render(QRhiCommandBuffer& commands, bool force)
               src->node->renderedNodes.find(this) != src->node->renderedNodes.end());
           NodeRenderer* renderer = src->node->renderedNodes.find(this)->second;
           prevRenderers.push_back({edge, renderer});
+          inputChanged |= renderer->changedThisFrame;
+        }
+
+        // Nothing changed since the last frame: the render target still has it
+        if(!inputChanged)
+        {
+          m_stats.skippedPasses++;
+          continue;
+        }
+        m_stats.renderedPasses++;
+        changed = true;
 
+        // First update them all
+        for(auto [edge, renderer] : prevRenderers)
+        {
           renderer->update(*this, *updateBatch);
         }
 
@@ -345,8 +384,7 @@ void RenderList::render(QRhiCommandBuffer& commands, bool force)
         // We *have* to do that in a single beginPass / endPass as every beginPass
         // issues a clearBuffers command.
         {
-          SCORE_ASSERT(node->renderedNodes.find(this) != node->renderedNodes.end());
-          auto rt = node->renderedNodes.find(this)->second->renderTargetForInput(*input);
+          auto rt = nodeRenderer->renderTargetForInput(*input);
 
           SCORE_ASSERT(rt.renderTarget);
 
@@ -361,12 +399,7 @@ void RenderList::render(QRhiCommandBuffer& commands, bool force)
 
           // Allow the node to do some actions, for instance if a readback
           // of a node's input is going to be needed.
-          {
-            SCORE_ASSERT(node->renderedNodes.find(this) != node->renderedNodes.end());
-            NodeRenderer* renderer = node->renderedNodes.find(this)->second;
-
-            renderer->inputAboutToFinish(*this, *input, res);
-          }
+          nodeRenderer->inputAboutToFinish(*this, *input, res);
           commands.endPass(res);
           res = nullptr;
         }
@@ -378,7 +411,9 @@ void RenderList::render(QRhiCommandBuffer& commands, bool force)
         }
       }
     }
+    nodeRenderer->changedThisFrame = changed;
   }
+  m_forceRender = false;
 
   // Finally the output node may have some rendering to do too
   {
@@ -6,6 +6,7 @@ namespace score::gfx
 {
 
 class OutputNode;
+class CustomMesh;
 /**
  * @brief List of nodes to be rendered to an output.
  *
@@ -89,8 +90,16 @@ public:
   RenderState& state;
 
   using Buffers = std::pair<const Mesh* const, MeshBuffers>;
-  Buffers
-  acquireMesh(const ossia::mesh_list_ptr&, QRhiResourceUpdateBatch& res) noexcept;
+
+  /**
+   * @brief Mesh and GPU buffers for the geometry of a node.
+   *
+   * They are kept across frames: when the geometry changes, only the buffers
+   * whose content changed are uploaded.
+   */
+  Buffers acquireMesh(
+      const Node& node, const ossia::mesh_list_ptr&,
+      QRhiResourceUpdateBatch& res) noexcept;
 
   /**
    * @brief Nodes present in this RenderList, in order
@@ -130,6 +139,19 @@ public:
 
   int samples() const noexcept { return m_samples; }
 
+  /**
+   * @brief Render passes run and skipped since this RenderList was created.
+   *
+   * Passes are skipped when the nodes they draw did not change, see
+   * Node::changeTracking.
+   */
+  struct Stats
+  {
+    int64_t renderedPasses{};
+    int64_t skippedPasses{};
+  };
+  const Stats& stats() const noexcept { return m_stats; }
+
   bool canRender() const noexcept { return m_ready; }
 
 private:
@@ -145,7 +167,7 @@ private:
    */
   ossia::flat_map<Mesh*, MeshBuffers> m_vertexBuffers;
 
-  ossia::flat_map<ossia::mesh_list_ptr, Mesh*> m_customMeshCache;
+  ossia::flat_map<const Node*, CustomMesh*> m_customMeshCache;
 
   /**
    * @brief Last size used by this renderer.
@@ -158,7 +180,10 @@ private:
 
   bool m_flip{};
 
+  Stats m_stats;
+
   bool m_ready{};
   bool m_built{};
+  bool m_forceRender{true};
 };
 }
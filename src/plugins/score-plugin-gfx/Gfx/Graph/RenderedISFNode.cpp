@@ -732,39 +732,41 @@ AudioTextureUpload::AudioTextureUpload()
 void AudioTextureUpload::process(
     AudioTexture& audio, QRhiResourceUpdateBatch& res, QRhiTexture* rhiTexture)
 {
-  if(audio.fft)
+  // When the same node is rendered to multiple outputs,
+  // the first renderer does the processing for all of them
+  if(audio.processedVersion != audio.version)
   {
-    processSpectral(audio, res, rhiTexture);
-  }
-  else
-  {
-    processTemporal(audio, res, rhiTexture);
-  }
-}
-
-void AudioTextureUpload::processTemporal(
-    AudioTexture& audio, QRhiResourceUpdateBatch& res, QRhiTexture* rhiTexture)
-{
-  if(m_scratchpad.size() < audio.data.size())
-    m_scratchpad.resize(audio.data.size());
-  for(std::size_t i = 0; i < audio.data.size(); i++)
-  {
-    m_scratchpad[i] = 0.5f + audio.data[i] / 2.f;
+    if(audio.fft)
+    {
+      processSpectral(audio);
+    }
+    else
+    {
+      processTemporal(audio);
+    }
+    audio.processedVersion = audio.version;
   }
 
   // Copy it
   QRhiTextureSubresourceUploadDescription subdesc(
-      m_scratchpad.data(), audio.data.size() * sizeof(float));
+      audio.processed.data(), audio.processed.size() * sizeof(float));
   QRhiTextureUploadEntry entry{0, 0, subdesc};
   QRhiTextureUploadDescription desc{entry};
   res.uploadTexture(rhiTexture, desc);
 }
 
-void AudioTextureUpload::processSpectral(
-    AudioTexture& audio, QRhiResourceUpdateBatch& res, QRhiTexture* rhiTexture)
+void AudioTextureUpload::processTemporal(AudioTexture& audio)
+{
+  audio.processed.resize(audio.data.size());
+  for(std::size_t i = 0; i < audio.data.size(); i++)
+  {
+    audio.processed[i] = 0.5f + audio.data[i] / 2.f;
+  }
+}
+
+void AudioTextureUpload::processSpectral(AudioTexture& audio)
 {
-  if(m_scratchpad.size() < audio.data.size())
-    m_scratchpad.resize(audio.data.size() / 2);
+  audio.processed.resize(audio.data.size() / 2);
   std::size_t bufferSize = audio.data.size() / audio.channels;
   std::size_t fftSize = bufferSize / 2;
   const float norm = 1. / (2. * bufferSize);
@@ -773,19 +775,12 @@ void AudioTextureUpload::processSpectral(
     float* inputData = audio.data.data() + i * bufferSize;
     auto spectrum = m_fft.execute(inputData, bufferSize);
 
-    float* outputSpectrum = m_scratchpad.data() + i * fftSize;
+    float* outputSpectrum = audio.processed.data() + i * fftSize;
     for(std::size_t k = 0; k < fftSize; k++)
     {
       outputSpectrum[k] = 0.5f + spectrum[k][0] * norm;
     }
   }
-
-  // Copy it
-  QRhiTextureSubresourceUploadDescription subdesc(
-      m_scratchpad.data(), (audio.data.size() / 2) * sizeof(float));
-  QRhiTextureUploadEntry entry{0, 0, subdesc};
-  QRhiTextureUploadDescription desc{entry};
-  res.uploadTexture(rhiTexture, desc);
 }
 
 std::optional<Sampler> AudioTextureUpload::updateAudioTexture(
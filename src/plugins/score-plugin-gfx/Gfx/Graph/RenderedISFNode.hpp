@@ -30,18 +30,14 @@ struct AudioTextureUpload
   void
   process(AudioTexture& audio, QRhiResourceUpdateBatch& res, QRhiTexture* rhiTexture);
 
-  void processTemporal(
-      AudioTexture& audio, QRhiResourceUpdateBatch& res, QRhiTexture* rhiTexture);
-
-  void processSpectral(
-      AudioTexture& audio, QRhiResourceUpdateBatch& res, QRhiTexture* rhiTexture);
+  void processTemporal(AudioTexture& audio);
+  void processSpectral(AudioTexture& audio);
 
   [[nodiscard]] std::optional<Sampler> updateAudioTexture(
       AudioTexture& audio, RenderList& renderer, char* materialData,
       QRhiResourceUpdateBatch& res);
 
 private:
-  std::vector<float> m_scratchpad;
   ossia::fft m_fft;
 };
 
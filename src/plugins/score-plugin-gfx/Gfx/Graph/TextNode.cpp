@@ -70,6 +70,7 @@ TextNode::TextNode()
   output.push_back(new Port{this, {}, Types::Image, {}});
 
   m_materialData.reset((char*)&ubo);
+  changeTracking = true;
 }
 
 TextNode::~TextNode()
@@ -89,29 +90,10 @@ private:
 
   // TODO
   QSize sz{1920, 1080};
-  void rerender()
-  {
-    auto& n = static_cast<const TextNode&>(this->node);
-
-    if(m_img.size().isNull())
-      m_img = QImage(sz, QImage::Format::Format_ARGB32_Premultiplied);
-    m_img.fill(Qt::transparent);
-    {
-      QPainter p{&m_img};
-      p.setRenderHint(QPainter::Antialiasing, true);
-      p.setRenderHint(QPainter::TextAntialiasing, true);
-
-      p.setFont(n.font);
-      p.setPen(n.pen);
-      p.drawText(10, 10, sz.width() - 20, sz.height() - 20, 0, n.text);
-    }
-
-    m_uploaded = false;
-  }
 
   void init(RenderList& renderer, QRhiResourceUpdateBatch& res) override
   {
-    rerender();
+    m_uploadedVersion = -1;
     const auto& mesh = renderer.defaultQuad();
     defaultMeshInit(renderer, mesh, res);
     processUBOInit(renderer);
@@ -152,19 +134,13 @@ private:
     if(m_textures.empty())
       return;
 
-    // If images haven't been uploaded yet, upload them.
-
+    // Upload the text if it changed since the last upload
     auto& n = static_cast<const TextNode&>(this->node);
-    if(n.mustRerender)
-    {
-      rerender();
-    }
-
-    if(!m_uploaded)
+    auto [img, version] = n.image();
+    if(version != m_uploadedVersion && !img.isNull())
     {
-      res.uploadTexture(m_textures[0].second, m_img);
-
-      m_uploaded = true;
+      res.uploadTexture(m_textures[0].second, img);
+      m_uploadedVersion = version;
     }
   }
 
@@ -185,9 +161,8 @@ private:
     defaultRelease(r);
   }
 
-  QImage m_img;
   std::vector<std::pair<score::gfx::Edge*, QRhiTexture*>> m_textures;
-  bool m_uploaded = false;
+  int64_t m_uploadedVersion{-1};
 };
 
 NodeRenderer* TextNode::createRenderer(RenderList& r) const noexcept
@@ -195,6 +170,39 @@ NodeRenderer* TextNode::createRenderer(RenderList& r) const noexcept
   return new Renderer{*this};
 }
 
+void TextNode::update()
+{
+  if(!mustRerender.exchange(false))
+    return;
+
+  // Drawn once for all the outputs
+  const QSize sz{1920, 1080};
+  QImage img{sz, QImage::Format::Format_ARGB32_Premultiplied};
+  img.fill(Qt::transparent);
+  {
+    QPainter p{&img};
+    p.setRenderHint(QPainter::Antialiasing, true);
+    p.setRenderHint(QPainter::TextAntialiasing, true);
+
+    p.setFont(font);
+    p.setPen(pen);
+    p.drawText(10, 10, sz.width() - 20, sz.height() - 20, 0, text);
+  }
+
+  {
+    std::lock_guard lck{m_imageLock};
+    m_image = std::move(img);
+    m_imageVersion++;
+  }
+  markChanged();
+}
+
+std::pair<QImage, int64_t> TextNode::image() const noexcept
+{
+  std::lock_guard lck{m_imageLock};
+  return {m_image, m_imageVersion};
+}
+
 void TextNode::process(Message&& msg)
 {
   ProcessNode::process(msg.token);
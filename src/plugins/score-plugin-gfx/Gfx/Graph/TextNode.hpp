@@ -3,8 +3,11 @@
 #include <Gfx/Graph/Node.hpp>
 
 #include <QFont>
+#include <QImage>
 #include <QPen>
 
+#include <mutex>
+
 namespace score::gfx
 {
 /**
@@ -19,6 +22,7 @@ public:
   score::gfx::NodeRenderer* createRenderer(RenderList& r) const noexcept override;
 
   void process(Message&& msg) override;
+  void update() override;
   class Renderer;
 
 #pragma pack(push, 1)
@@ -37,7 +41,18 @@ public:
 
   std::atomic_bool mustRerender{true};
 
+  /**
+   * @brief The rendered text, shared by the renderers of every output.
+   *
+   * The text is drawn once when it changes, each renderer then only has
+   * to upload it to its own texture.
+   */
+  std::pair<QImage, int64_t> image() const noexcept;
+
 private:
+  mutable std::mutex m_imageLock;
+  QImage m_image;
+  int64_t m_imageVersion{};
 };
 
 }
@@ -37,6 +37,13 @@ struct AudioTexture
   int fixedSize{0};
   int rectUniformOffset{};
   bool fft{};
+
+  // Incremented each time new audio data comes in
+  int64_t version{};
+
+  // The data as it goes in the texture, computed once for all the outputs
+  std::vector<float> processed;
+  int64_t processedVersion{-1};
 };
 
 /**
@@ -138,12 +145,14 @@ struct TextureRenderTarget
 };
 
 /**
- * @brief Image data and metadata.
+ * @brief An image file: the size of each of its frames.
+ *
+ * The pixels are decoded on demand, see ImageSequence.
  */
 struct Image
 {
   QString path;
-  std::vector<QImage> frames;
+  std::vector<QSize> frames;
 };
 
 /**
@@ -159,25 +159,41 @@ static std::optional<score::gfx::Image> readImage(const QString& filename)
   if(!isSupportedImage(info))
     return {};
 
+  // Only the header is read here: frames are decoded during playback
   QImageReader reader{filename};
-  reader.setBackgroundColor(Qt::transparent);
-  std::vector<QImage> frames;
-  while(reader.canRead())
+  if(!reader.canRead())
+    return {};
+
+  // imageCount() is 0 when the format does not know it: read until the end
+  const int count = reader.imageCount();
+  std::vector<QSize> frames;
+  for(int i = 0; count <= 0 || i < count; i++)
   {
-    QImage img = reader.read();
+    if(i > 0 && !reader.canRead())
+      break;
 
-    if(img.isNull() || img.size() == QSize{})
-      continue;
+    // Not every frame necessarily has the size of the first one
+    QSize size = reader.size();
+    bool decoded = false;
+    if(!size.isValid())
+    {
+      size = reader.read().size();
+      decoded = true;
+    }
+    if(size.isEmpty())
+      break;
 
-    if(img.format() != QImage::Format_ARGB32)
-      img.convertTo(QImage::Format_ARGB32);
+    frames.push_back(size);
+    if(i + 1 == count)
+      break;
 
-    frames.push_back(std::move(img));
+    // Formats which cannot skip a frame have to decode it
+    if(!decoded && !reader.jumpToNextImage() && reader.read().isNull())
+      break;
   }
 
   if(frames.empty())
     return {};
-
   return score::gfx::Image{filename, std::move(frames)};
 }
 
@@ -215,6 +231,7 @@ namespace Gfx
 
 std::optional<score::gfx::Image> ImageCache::acquire(const std::string& path)
 {
+  std::lock_guard lck{m_lock};
   if(auto it = m_images.find(path); it != m_images.end())
   {
     it->second.first++;
@@ -231,6 +248,7 @@ std::optional<score::gfx::Image> ImageCache::acquire(const std::string& path)
 
 void ImageCache::release(score::gfx::Image&& img)
 {
+  std::lock_guard lck{m_lock};
   if(auto it = m_images.find(img.path.toStdString()); it != m_images.end())
   {
     it->second.first--;
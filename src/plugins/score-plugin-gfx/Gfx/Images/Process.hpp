@@ -13,6 +13,8 @@
 
 #include <ossia/detail/hash_map.hpp>
 
+#include <mutex>
+
 namespace Gfx
 {
 std::vector<score::gfx::Image> getImages(const ossia::value& val);
@@ -28,6 +30,8 @@ public:
   static ImageCache& instance() noexcept;
 
 private:
+  // Used from the UI and rendering threads
+  std::mutex m_lock;
   ossia::hash_map<std::string, std::pair<int, score::gfx::Image>> m_images;
 };
 }
@@ -0,0 +1,130 @@
+#include "MeshSnapshot.hpp"
+
+#include <atomic>
+#include <cstring>
+
+namespace Gfx
+{
+// Unique across all the snapshots, as a node can get its geometry from several
+static std::atomic_int64_t snapshot_index{};
+
+// Comparing larger buffers costs about as much as uploading them again
+static constexpr int64_t max_compared_size = 64 * 1024;
+
+// Buffers held by the last copies, plus the free ones.
+// Only a starting size: the pool grows if more buffers are in use.
+static constexpr std::size_t pool_size = 32;
+
+mesh_snapshot::mesh_snapshot()
+{
+  for(auto& slot : m_slots)
+    slot = std::make_shared<ossia::mesh_list>();
+  m_pool.reserve(pool_size);
+}
+
+ossia::mesh_list_ptr
+mesh_snapshot::update(const ossia::mesh_list_ptr& source, int64_t inputUpdates)
+{
+  if(!source)
+  {
+    m_source.reset();
+    m_last.reset();
+    return {};
+  }
+
+  if(source == m_source && source->dirty_index == m_sourceIndex && m_last)
+    return m_last;
+
+  // The render thread has not taken the last copy yet: a new one would be wasted
+  if(m_last && inputUpdates == m_lastInputUpdates)
+    return m_last;
+
+  auto* free_slot = acquire_slot();
+  if(!free_slot)
+  {
+    // The renderers hold every copy: the source is copied at a later tick
+    return m_last;
+  }
+
+  auto& slot = *free_slot;
+  const ossia::mesh_list* previous = m_last.get();
+
+  // Copies the description of the meshes, then their content
+  *slot = *source;
+  for(std::size_t m = 0; m < slot->meshes.size(); m++)
+  {
+    auto& buffers = slot->meshes[m].buffers;
+    for(std::size_t b = 0; b < buffers.size(); b++)
+    {
+      const buffer* prev_buffer{};
+      if(previous && m < previous->meshes.size()
+         && b < previous->meshes[m].buffers.size())
+        prev_buffer = &previous->meshes[m].buffers[b];
+
+      buffers[b].data = copy(source->meshes[m].buffers[b], prev_buffer);
+    }
+  }
+  slot->dirty_index = ++snapshot_index;
+
+  m_source = source;
+  m_sourceIndex = source->dirty_index;
+  m_last = slot;
+  m_lastInputUpdates = inputUpdates;
+  return m_last;
+}
+
+ossia::mesh_list_ptr* mesh_snapshot::acquire_slot()
+{
+  // m_last holds a reference to the previous copy, so it is never reused here
+  for(auto& slot : m_slots)
+  {
+    if(slot.use_count() == 1)
+    {
+      // Synchronizes with the release of the last reference by the renderer
+      std::atomic_thread_fence(std::memory_order_acquire);
+      return &slot;
+    }
+  }
+  return nullptr;
+}
+
+mesh_snapshot::buffer_data
+mesh_snapshot::copy(const buffer& source, const buffer* previous)
+{
+  const auto size = source.size;
+  const auto data = source.data.get();
+  if(size <= 0 || !data)
+    return {};
+
+  if(previous && previous->size == size && previous->data
+     && size <= max_compared_size
+     && std::memcmp(previous->data.get(), data, size) == 0)
+    return previous->data;
+
+  // Reuse a buffer which is not held by a renderer anymore
+  std::pair<buffer_data, int64_t>* free_buffer{};
+  for(auto& p : m_pool)
+  {
+    if(p.first.use_count() == 1)
+    {
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if(p.second >= size)
+      {
+        std::memcpy(p.first.get(), data, size);
+        return p.first;
+      }
+      free_buffer = &p;
+    }
+  }
+
+  // The geometry grew: leave room for it to grow further
+  const int64_t capacity = size + size / 2;
+  buffer_data ptr{new char[capacity], std::default_delete<char[]>{}};
+  std::memcpy(ptr.get(), data, size);
+  if(free_buffer)
+    *free_buffer = {ptr, capacity};
+  else
+    m_pool.emplace_back(ptr, capacity);
+  return ptr;
+}
+}
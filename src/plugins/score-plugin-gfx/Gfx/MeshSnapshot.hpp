@@ -0,0 +1,60 @@
+#pragma once
+#include <ossia/dataflow/geometry_port.hpp>
+
+#include <score_plugin_gfx_export.h>
+
+#include <array>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Gfx
+{
+/**
+ * @brief Copies the geometry sent by a port for the render thread.
+ *
+ * Producers keep writing to their meshes after sending them: the render
+ * thread gets a copy made in the execution thread instead.
+ * This costs a copy of the whole geometry in the execution thread, at most
+ * about once per rendered frame: while the render thread has not taken the
+ * last copy, the changes of the source wait for the next one.
+ * The copies are made in recycled buffers, which are written to again once
+ * no renderer holds them anymore: usually three are in use, one being
+ * uploaded, one in flight and one being written. If the renderers lag behind
+ * and hold all of them, the previous copy is sent again instead of
+ * allocating. Buffers only allocate when the geometry grows, with headroom,
+ * or when more of them are in use than ever before.
+ * The small buffers whose content did not change are shared with the
+ * previous copy, which lets the renderers skip uploading them.
+ *
+ * Only used from the execution thread.
+ */
+class SCORE_PLUGIN_GFX_EXPORT mesh_snapshot
+{
+public:
+  mesh_snapshot();
+
+  /**
+   * @brief Returns the same copy as long as the source does not change.
+   *
+   * inputUpdates is GfxContext::input_updates(), which tells whether the
+   * render thread took the last copy.
+   */
+  ossia::mesh_list_ptr update(const ossia::mesh_list_ptr& source, int64_t inputUpdates);
+
+private:
+  using buffer = std::decay_t<decltype(std::declval<ossia::geometry&>().buffers[0])>;
+  using buffer_data = decltype(buffer::data);
+
+  ossia::mesh_list_ptr* acquire_slot();
+  buffer_data copy(const buffer& source, const buffer* previous);
+
+  std::array<ossia::mesh_list_ptr, 3> m_slots;
+  std::vector<std::pair<buffer_data, int64_t>> m_pool;
+
+  ossia::mesh_list_ptr m_source;
+  int64_t m_sourceIndex{-1};
+  ossia::mesh_list_ptr m_last;
+  int64_t m_lastInputUpdates{-1};
+};
+}
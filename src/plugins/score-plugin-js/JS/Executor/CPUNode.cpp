@@ -6,6 +6,8 @@
 #include <score/serialization/AnySerialization.hpp>
 #include <score/serialization/MapSerialization.hpp>
 
+#include <ossia/math/safe_math.hpp>
+
 #include <QCoreApplication>
 #include <QDir>
 #include <QEventLoop>
@@ -169,21 +171,21 @@ void js_node::run(
       m_object->resume().call();
   }
 
-  // Copy audio
+  // Copy audio into the persistent typed arrays of the inlets
   for(std::size_t inl_i = 0; inl_i < m_audInlets.size(); inl_i++)
   {
     auto& dat = m_audInlets[inl_i].second->target<ossia::audio_port>()->get();
+    auto& audio = m_audInlets[inl_i].first->audio();
 
     const int dat_size = std::ssize(dat);
-    QVector<QVector<double>> audio(dat_size);
+    int frames = 0;
+    for(auto& chan : dat)
+      frames = std::max(frames, int(chan.size()));
+
+    audio.reserve(*m_engine, dat_size, frames);
+    audio.zero();
     for(int i = 0; i < dat_size; i++)
-    {
-      const int dat_i_size = dat[i].size();
-      audio[i].resize(dat_i_size);
-      for(int j = 0; j < dat_i_size; j++)
-        audio[i][j] = dat[i][j];
-    }
-    m_audInlets[inl_i].first->setAudio(audio);
+      std::copy_n(dat[i].data(), dat[i].size(), audio.data(i));
   }
 
   // Copy values
@@ -206,13 +208,13 @@ void js_node::run(
     }
     else
     {
+      auto& inl = *m_valInlets[i].first;
       for(auto& val : dat)
       {
         // TODO why not js_value_outbound_visitor ? it makes more sense.
         auto qvar = val.value.apply(ossia::qt::ossia_to_qvariant{});
-        m_valInlets[i].first->setValue(qvar);
-        m_valInlets[i].first->addValue(
-            QVariant::fromValue(InValueMessage{(double)val.timestamp, std::move(qvar)}));
+        inl.addValue(QVariant::fromValue(InValueMessage{(double)val.timestamp, qvar}));
+        inl.setValue(std::move(qvar));
       }
     }
   }
@@ -250,6 +252,10 @@ void js_node::run(
     m_midInlets[i].first->setMidi(dat);
   }
 
+  const auto [tick_start, d] = estate.timings(tk);
+  for(auto& [js_port, ossia_port] : m_audOutlets)
+    js_port->beginTick(*m_engine, d);
+
   if(m_tickCall.empty())
     m_tickCall = {{}, {}};
 
@@ -263,7 +269,6 @@ void js_node::run(
              << res.toString();
   }
 
-  const auto [tick_start, d] = estate.timings(tk);
   for(std::size_t i = 0; i < m_valOutlets.size(); i++)
   {
     auto& ossia_port = *m_valOutlets[i].second->target<ossia::value_port>();
@@ -301,13 +306,17 @@ void js_node::run(
   {
     auto& src = m_audOutlets[out].first->audio();
     auto& snk = m_audOutlets[out].second->target<ossia::audio_port>()->get();
-    snk.resize(src.size());
-    for(int chan = 0; chan < src.size(); chan++)
+    const int channels = m_audOutlets[out].first->usedChannels();
+    const int frames = src.frames();
+    snk.resize(channels);
+    for(int chan = 0; chan < channels; chan++)
     {
-      snk[chan].resize(src[chan].size() + tick_start);
+      snk[chan].resize(frames + tick_start);
 
-      for(int j = 0; j < src[chan].size(); j++)
-        snk[chan][j + tick_start] = src[chan][j];
+      const double* in = src.data(chan);
+      double* outp = snk[chan].data() + tick_start;
+      for(int j = 0; j < frames; j++)
+        outp[j] = ossia::safe_isinf(in[j]) || ossia::safe_isnan(in[j]) ? 0. : in[j];
     }
   }
 
@@ -317,7 +326,5 @@ void js_node::run(
       m_object->stop().call();
   }
   e.processEvents();
-  if(m_gcIndex++ % 64 == 0)
-    m_engine->collectGarbage();
 }
 }
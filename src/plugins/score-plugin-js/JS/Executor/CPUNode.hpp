@@ -50,7 +50,6 @@ public:
   JS::Script* m_object{};
   ExecStateWrapper* m_execFuncs{};
   QJSValueList m_tickCall;
-  std::size_t m_gcIndex{};
 
   bool triggerStart{};
   bool triggerStop{};
@@ -0,0 +1,112 @@
+#include "AudioChannels.hpp"
+
+#include <QJSEngine>
+
+#include <private/qjsvalue_p.h>
+#include <private/qv4arraybuffer_p.h>
+#include <private/qv4engine_p.h>
+#include <private/qv4scopedvalue_p.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace JS
+{
+
+AudioChannels::AudioChannels() = default;
+AudioChannels::~AudioChannels() = default;
+
+void AudioChannels::reserve(QJSEngine& engine, int channels, int frames)
+{
+  channels = std::max(channels, 0);
+  frames = std::max(frames, 0);
+
+  const int allocated = std::ssize(m_buffers);
+  if(frames > m_capacity)
+    reallocate(engine, std::max(channels, allocated), frames);
+  else if(channels > allocated)
+    reallocate(engine, channels, m_capacity);
+
+  m_channels = channels;
+  m_frames = frames;
+  updateViews(engine);
+}
+
+void AudioChannels::reallocate(QJSEngine& engine, int channels, int capacity)
+{
+  QV4::ExecutionEngine* v4 = engine.handle();
+  QV4::Scope scope(v4);
+
+  // Only the missing buffers are allocated, unless they all have to grow
+  int first = std::ssize(m_buffers);
+  if(capacity != m_capacity)
+  {
+    first = 0;
+    for(auto& v : m_views)
+      v = {};
+  }
+
+  m_buffers.resize(channels);
+  m_data.resize(channels);
+  for(int i = first; i < channels; i++)
+  {
+    QV4::Scoped<QV4::ArrayBuffer> buffer(
+        scope, v4->newArrayBuffer(std::size_t(capacity) * sizeof(double)));
+    // The V4 garbage collector does not move objects:
+    // the storage stays valid as long as we reference the buffer.
+    m_data[i] = reinterpret_cast<double*>(buffer->arrayData());
+    std::fill_n(m_data[i], capacity, 0.);
+    m_buffers[i] = QJSValuePrivate::fromReturnedValue(buffer->asReturnedValue());
+  }
+  m_capacity = capacity;
+}
+
+void AudioChannels::updateViews(QJSEngine& engine)
+{
+  auto it = std::find_if(m_views.begin(), m_views.end(), [this](const Views& v) {
+    return v.frames == m_frames;
+  });
+  if(it == m_views.end())
+  {
+    // Replaces the oldest length
+    it = m_views.begin() + m_nextViews;
+    m_nextViews = (m_nextViews + 1) % std::ssize(m_views);
+    *it = {m_frames, {}};
+  }
+  m_currentViews = it - m_views.begin();
+
+  auto& views = it->channels;
+  if(std::ssize(views) >= m_channels)
+    return;
+
+  const QJSValue ctor = engine.globalObject().property("Float64Array");
+  for(int i = std::ssize(views); i < m_channels; i++)
+    views.push_back(ctor.callAsConstructor({m_buffers[i], 0, m_frames}));
+}
+
+void AudioChannels::zero() noexcept
+{
+  for(int i = 0; i < m_channels; i++)
+    std::fill_n(m_data[i], m_frames, 0.);
+}
+
+void AudioChannels::clear()
+{
+  m_buffers.clear();
+  m_data.clear();
+  for(auto& v : m_views)
+    v = {};
+  m_currentViews = 0;
+  m_nextViews = 0;
+  m_channels = 0;
+  m_frames = 0;
+  m_capacity = 0;
+}
+
+QJSValue AudioChannels::channel(int i) const
+{
+  if(i >= 0 && i < m_channels)
+    return m_views[m_currentViews].channels[i];
+  return {};
+}
+}
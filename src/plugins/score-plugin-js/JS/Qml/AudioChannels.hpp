@@ -0,0 +1,61 @@
+#pragma once
+#include <QJSValue>
+
+#include <array>
+#include <vector>
+
+class QJSEngine;
+namespace JS
+{
+/**
+ * @brief Audio channels exposed to scripts as Float64Array.
+ *
+ * The samples live in ArrayBuffers allocated once in the JS heap:
+ * the executor copies to / from them with memcpy, and scripts get the same
+ * typed array objects at every tick of the same length, so no per-tick
+ * allocation or per-sample conversion happens on either side.
+ *
+ * Float64Array matches the sample type of ossia's audio buffers.
+ */
+class AudioChannels
+{
+public:
+  AudioChannels();
+  ~AudioChannels();
+
+  // Sets the number of channels and the length of every view.
+  // Existing buffers are kept as long as they are large enough: views
+  // obtained earlier stay valid when channels are added.
+  void reserve(QJSEngine& engine, int channels, int frames);
+  void zero() noexcept;
+  void clear();
+
+  // Channels of the current tick: can be less than the allocated ones
+  int channels() const noexcept { return m_channels; }
+  int frames() const noexcept { return m_frames; }
+  double* data(int channel) const noexcept { return m_data[channel]; }
+
+  QJSValue channel(int i) const;
+
+private:
+  void reallocate(QJSEngine& engine, int channels, int capacity);
+  void updateViews(QJSEngine& engine);
+
+  std::vector<QJSValue> m_buffers;
+  std::vector<double*> m_data;
+
+  // Views of the last tick lengths, e.g. full buffers and the end of a loop
+  struct Views
+  {
+    int frames{-1};
+    std::vector<QJSValue> channels;
+  };
+  std::array<Views, 4> m_views;
+  int m_currentViews{};
+  int m_nextViews{};
+
+  int m_channels{};
+  int m_frames{};
+  int m_capacity{};
+};
+}
@@ -2,8 +2,7 @@
 
 #include <JS/Qml/Metatypes.hpp>
 
-#include <ossia/math/safe_math.hpp>
-
+#include <QJSEngine>
 #include <QVector2D>
 #include <QVector3D>
 #include <QVector4D>
@@ -196,26 +195,34 @@ AudioInlet::AudioInlet(QObject* parent)
 
 AudioInlet::~AudioInlet() { }
 
-const QVector<QVector<double>>& AudioInlet::audio() const
+AudioOutlet::AudioOutlet(QObject* parent)
+    : Outlet{parent}
 {
-  return m_audio;
 }
 
-void AudioInlet::setAudio(const QVector<QVector<double>>& audio)
+AudioOutlet::~AudioOutlet() { }
+
+void AudioOutlet::beginTick(QJSEngine& engine, int frames)
 {
-  m_audio = audio;
+  m_audio.reserve(engine, m_audio.channels(), frames);
+  m_audio.zero();
 }
 
-AudioOutlet::AudioOutlet(QObject* parent)
-    : Outlet{parent}
+QJSValue AudioOutlet::channel(int i)
 {
-}
+  if(i < 0)
+    return {};
 
-AudioOutlet::~AudioOutlet() { }
+  if(i >= m_audio.channels())
+  {
+    auto engine = qjsEngine(this);
+    if(!engine)
+      return {};
+    m_audio.reserve(*engine, i + 1, m_audio.frames());
+  }
 
-const QVector<QVector<double>>& AudioOutlet::audio() const
-{
-  return m_audio;
+  m_usedChannels = std::max(m_usedChannels, i + 1);
+  return m_audio.channel(i);
 }
 
 #if defined(SCORE_HAS_GPU_JS)
@@ -253,28 +260,26 @@ const QVector<QVector<int>>& MidiOutlet::midi() const
 
 void AudioOutlet::setChannel(int i, const QJSValue& v)
 {
-  if(i < 0)
-    i = 0;
-  if(i + 1 > std::ssize(m_audio))
-    m_audio.resize(i + 1);
-
-  int n = v.property("length").toNumber();
-  auto& arr = m_audio[i];
-  arr.clear();
-  arr.resize(n);
-  double* data = arr.data();
-  for(int s = 0; s < n; s++)
+  QJSValue dest = channel(i);
+  if(dest.isUndefined())
+    return;
+
+  // Fast path: typed arrays and arrays that fit are copied natively by the engine
+  const int n = v.property("length").toInt();
+  if(n <= m_audio.frames())
+  {
+    if(!dest.property("set").callWithInstance(dest, {v}).isError())
+      return;
+  }
+
+  const int frames = std::min(n, m_audio.frames());
+  double* data = m_audio.data(i);
+  for(int s = 0; s < frames; s++)
   {
     if(const auto& prop = v.property(s); prop.isNumber())
-    {
       data[s] = prop.toNumber();
-      if(ossia::safe_isinf(data[s]) || ossia::safe_isnan(data[s]))
-        data[s] = 0.;
-    }
     else
-    {
       data[s] = 0.;
-    }
   }
 }
 
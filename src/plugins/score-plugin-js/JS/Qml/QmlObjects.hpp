@@ -4,6 +4,7 @@
 #include <Process/Dataflow/Port.hpp>
 #include <Process/Dataflow/WidgetInlets.hpp>
 
+#include <JS/Qml/AudioChannels.hpp>
 #include <JS/Qml/QtMetatypes.hpp>
 
 #if defined(SCORE_HAS_GPU_JS)
@@ -415,24 +416,23 @@ class AudioInlet : public Inlet
 public:
   explicit AudioInlet(QObject* parent = nullptr);
   virtual ~AudioInlet() override;
-  const QVector<QVector<double>>& audio() const;
-  void setAudio(const QVector<QVector<double>>& audio);
+  AudioChannels& audio() noexcept { return m_audio; }
+  const AudioChannels& audio() const noexcept { return m_audio; }
 
-  QVector<double> channel(int i) const
-  {
-    if(m_audio.size() > i)
-      return m_audio[i];
-    return {};
-  }
+  // Float64Array, valid for the current tick
+  QJSValue channel(int i) const { return m_audio.channel(i); }
   W_INVOKABLE(channel);
 
+  int channelCount() const noexcept { return m_audio.channels(); }
+  W_INVOKABLE(channelCount);
+
   Process::Inlet* make(Id<Process::Port>&& id, QObject* parent) override
   {
     return new Process::AudioInlet(id, parent);
   }
 
 private:
-  QVector<QVector<double>> m_audio;
+  AudioChannels m_audio;
 };
 
 class AudioOutlet : public Outlet
@@ -450,12 +450,23 @@ public:
     return p;
   }
 
-  const QVector<QVector<double>>& audio() const;
+  AudioChannels& audio() noexcept { return m_audio; }
+  const AudioChannels& audio() const noexcept { return m_audio; }
+
+  // Number of channels obtained by the script so far. Their buffers persist
+  // across ticks, so a script can keep them instead of asking at every tick.
+  int usedChannels() const noexcept { return m_usedChannels; }
+  void beginTick(QJSEngine& engine, int frames);
+
+  // Float64Array of the tick's length that scripts can write in place
+  QJSValue channel(int i);
+  W_INVOKABLE(channel)
 
   void setChannel(int i, const QJSValue& v);
   W_INVOKABLE(setChannel)
 private:
-  QVector<QVector<double>> m_audio;
+  AudioChannels m_audio;
+  int m_usedChannels{};
 };
 
 class MidiMessage
@@ -122,23 +122,34 @@ class LibraryHandler final
 
   void addPath(std::string_view path) override
   {
+    addPathFromMetadata(path, readMetadata(path));
+  }
+
+  // The script itself, if it is a score script
+  QByteArray readMetadata(std::string_view path) const noexcept override
+  {
+    QFile f(QString::fromUtf8(path.data(), path.length()));
+    if(!f.open(QIODevice::ReadOnly))
+      return {};
+
+    auto script = f.readAll().trimmed();
+    if(!scoreImport.match(QString::fromUtf8(script)).hasMatch())
+      return QByteArray{""}; // Cached so that other QML files are not read again
+    return script;
+  }
+
+  void
+  addPathFromMetadata(std::string_view path, const QByteArray& metadata) override
+  {
+    if(metadata.isEmpty())
+      return;
+
     QFileInfo file{QString::fromUtf8(path.data(), path.length())};
     Library::ProcessData pdata;
     pdata.prettyName = file.completeBaseName();
     pdata.key = Metadata<ConcreteKey_k, JS::ProcessModel>::get();
-    pdata.customData = [&] {
-      QFile f(file.absoluteFilePath());
-      f.open(QIODevice::ReadOnly);
-      return f.readAll().trimmed();
-    }();
-
-    {
-      auto matches = scoreImport.match(pdata.customData);
-      if(matches.hasMatch())
-      {
-        categories.add(file, std::move(pdata));
-      }
-    }
+    pdata.customData = QString::fromUtf8(metadata);
+    categories.add(file, std::move(pdata));
   }
 };
 
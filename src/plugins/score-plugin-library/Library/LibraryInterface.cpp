@@ -22,6 +22,16 @@ void LibraryInterface::addPath(std::string_view) { }
 
 void LibraryInterface::removePath(std::string_view) { }
 
+QByteArray LibraryInterface::readMetadata(std::string_view) const noexcept
+{
+  return {};
+}
+
+void LibraryInterface::addPathFromMetadata(std::string_view path, const QByteArray&)
+{
+  addPath(path);
+}
+
 QSet<QString> LibraryInterface::acceptedFiles() const noexcept
 {
   return {};
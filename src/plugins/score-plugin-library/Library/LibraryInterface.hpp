@@ -34,6 +34,21 @@ public:
   virtual void setup(ProcessesItemModel& model, const score::GUIApplicationContext& ctx);
   virtual void addPath(std::string_view);
   virtual void removePath(std::string_view);
+
+  /**
+   * Reads from a file what is needed to add it to the library.
+   *
+   * Called from worker threads during library scans, thus must not touch
+   * the item models. The result is stored in the library index, so that it
+   * is only called again when the file changes, unless it is null: this means
+   * that the file could not be read for now. An empty, non-null result means
+   * that the file is not meant for this handler.
+   */
+  virtual QByteArray readMetadata(std::string_view path) const noexcept;
+
+  //! Called on the GUI thread with the result of readMetadata. Calls addPath by default.
+  virtual void addPathFromMetadata(std::string_view path, const QByteArray& metadata);
+
   virtual bool onDrop(const QMimeData& mime, int row, int column, const QDir& parent);
 
   virtual bool onDoubleClick(const QString& path, const score::DocumentContext& ctx);
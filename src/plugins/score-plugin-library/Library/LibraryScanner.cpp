@@ -0,0 +1,201 @@
+#include "LibraryScanner.hpp"
+
+#include <Library/LibraryInterface.hpp>
+
+#include <score/tools/RecursiveWatch.hpp>
+#include <score/tools/ThreadPool.hpp>
+
+#include <ossia/detail/hash_map.hpp>
+#include <ossia/detail/thread.hpp>
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+namespace Library
+{
+namespace
+{
+static constexpr quint32 index_magic = 0x53434c49; // "SCLI"
+static constexpr quint32 index_version = 1;
+
+// Number of files handed to the GUI thread at once
+static constexpr int batch_size = 256;
+
+struct IndexEntry
+{
+  qint64 modified{};
+  qint64 size{};
+  QByteArray metadata;
+};
+
+// Key: uuid of the handler followed by the path
+using Index = ossia::hash_map<QByteArray, IndexEntry>;
+
+static QByteArray indexKey(const LibraryInterface& handler, const std::string& path)
+{
+  QByteArray k = score::uuids::toByteArray(handler.concreteKey().impl());
+  k.append(path.data(), path.size());
+  return k;
+}
+
+static Index loadIndex(const QString& path)
+{
+  Index index;
+  QFile f{path};
+  if(!f.open(QIODevice::ReadOnly))
+    return index;
+
+  QDataStream s{&f};
+  quint32 magic{}, version{}, count{};
+  s >> magic >> version >> count;
+  if(magic != index_magic || version != index_version)
+    return index;
+
+  index.reserve(count);
+  for(quint32 i = 0; i < count && s.status() == QDataStream::Ok; i++)
+  {
+    QByteArray key;
+    IndexEntry e;
+    s >> key >> e.modified >> e.size >> e.metadata;
+    index.emplace(std::move(key), std::move(e));
+  }
+
+  if(s.status() != QDataStream::Ok)
+    index.clear();
+  return index;
+}
+
+static void saveIndex(const QString& path, const Index& index)
+{
+  QDir{}.mkpath(QFileInfo{path}.absolutePath());
+
+  QSaveFile f{path};
+  if(!f.open(QIODevice::WriteOnly))
+    return;
+
+  QDataStream s{&f};
+  s << index_magic << index_version << quint32(index.size());
+  for(const auto& [key, e] : index)
+    s << key << e.modified << e.size << e.metadata;
+
+  if(!f.commit())
+    qDebug() << "Could not save the library index: " << path;
+}
+}
+
+LibraryScanner::LibraryScanner(
+    const QString& root, const std::vector<LibraryInterface*>& handlers,
+    QObject* context, std::function<void(Batch&)> onBatch)
+    : m_root{root.toStdString()}
+    , m_context{context}
+    , m_onBatch{std::move(onBatch)}
+    , m_valid{std::make_shared<bool>(true)}
+{
+  for(auto* handler : handlers)
+    for(const QString& ext : handler->acceptedFiles())
+      m_handlers[ext.toStdString()].push_back(handler);
+
+  m_thread = std::thread{[this] {
+    ossia::set_thread_name("ossia library");
+    this->run();
+  }};
+}
+
+LibraryScanner::~LibraryScanner()
+{
+  *m_valid = false;
+  m_cancel = true;
+  if(m_thread.joinable())
+    m_thread.join();
+}
+
+QString LibraryScanner::indexPath()
+{
+  return QStandardPaths::writableLocation(QStandardPaths::CacheLocation)
+         + QStringLiteral("/library.index");
+}
+
+void LibraryScanner::run()
+{
+#if !defined(SCORE_DEPLOYMENT_BUILD)
+  static const bool disable_library = qEnvironmentVariableIsSet("SCORE_DISABLE_LIBRARY");
+  if(Q_UNLIKELY(disable_library))
+    return;
+#endif
+
+  Batch files;
+  score::for_all_files(m_root, [this, &files](std::string_view path) {
+    if(m_cancel || path.empty())
+      return;
+    if(auto last_dot = path.find_last_of('.'); last_dot < path.size() - 1)
+    {
+      std::string_view suffix = path.substr(last_dot + 1);
+      if(auto it = m_handlers.find(suffix); it != m_handlers.end())
+        for(auto* handler : it->second)
+          files.push_back({handler, std::string(path), {}});
+    }
+  });
+
+  const QString index_path = indexPath();
+  const Index previous = loadIndex(index_path);
+  Index current;
+  current.reserve(files.size());
+
+  const int count = std::ssize(files);
+  std::vector<QByteArray> keys(batch_size);
+  std::vector<IndexEntry> entries(batch_size);
+  for(int first = 0; first < count; first += batch_size)
+  {
+    if(m_cancel)
+      return;
+
+    const int n = std::min(batch_size, count - first);
+    score::parallel_for(n, [&](int i) {
+      auto& file = files[first + i];
+      auto& entry = entries[i];
+      keys[i] = indexKey(*file.handler, file.path);
+
+      const QFileInfo info{QString::fromStdString(file.path)};
+      entry.modified = info.lastModified().toMSecsSinceEpoch();
+      entry.size = info.size();
+
+      auto it = previous.find(keys[i]);
+      if(it != previous.end() && it->second.modified == entry.modified
+         && it->second.size == entry.size && !it->second.metadata.isNull())
+        entry.metadata = it->second.metadata;
+      else
+        entry.metadata = file.handler->readMetadata(file.path);
+
+      file.metadata = entry.metadata;
+    }, score::TaskPool::Priority::Low);
+
+    // Null metadata is not cached: e.g. presets whose plug-in is not loaded
+    // yet are read again at the next scan
+    for(int i = 0; i < n; i++)
+      if(!entries[i].metadata.isNull())
+        current.insert_or_assign(std::move(keys[i]), std::move(entries[i]));
+
+    Batch batch{
+        std::make_move_iterator(files.begin() + first),
+        std::make_move_iterator(files.begin() + first + n)};
+    QMetaObject::invokeMethod(
+        m_context,
+        [this, valid = m_valid, batch = std::move(batch)]() mutable {
+      // The scanner may have been destroyed since
+      if(*valid)
+        m_onBatch(batch);
+    },
+        Qt::QueuedConnection);
+  }
+
+  // Entries for files which were removed are dropped at this point
+  if(!m_cancel)
+    saveIndex(index_path, current);
+}
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include <ossia/detail/string_map.hpp>
+
+#include <QByteArray>
+#include <QObject>
+#include <QString>
+
+#include <score_plugin_library_export.h>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Library
+{
+class LibraryInterface;
+
+/**
+ * @brief Scans the packages folder on a background thread.
+ *
+ * Files accepted by a LibraryInterface are looked up in a persistent index,
+ * keyed by path, modification time and size: only the files which are new or
+ * have changed since the last scan are read, through
+ * LibraryInterface::readMetadata, on several threads at once.
+ *
+ * The results are handed to the GUI thread in batches, in the order in which
+ * the files were found, and the index is saved once the scan is complete.
+ */
+class SCORE_PLUGIN_LIBRARY_EXPORT LibraryScanner
+{
+public:
+  struct Entry
+  {
+    LibraryInterface* handler{};
+    std::string path;
+    QByteArray metadata;
+  };
+  using Batch = std::vector<Entry>;
+
+  //! onBatch is called on the thread of context
+  LibraryScanner(
+      const QString& root, const std::vector<LibraryInterface*>& handlers,
+      QObject* context, std::function<void(Batch&)> onBatch);
+  LibraryScanner(const LibraryScanner&) = delete;
+  LibraryScanner& operator=(const LibraryScanner&) = delete;
+
+  //! Cancels the scan: batches which were not delivered yet are dropped
+  ~LibraryScanner();
+
+  static QString indexPath();
+
+private:
+  void run();
+
+  std::string m_root;
+  ossia::string_map<std::vector<LibraryInterface*>> m_handlers;
+  QObject* m_context{};
+  std::function<void(Batch&)> m_onBatch;
+
+  // Only accessed from the thread of m_context
+  std::shared_ptr<bool> m_valid;
+
+  std::atomic_bool m_cancel{};
+  std::thread m_thread;
+};
+}
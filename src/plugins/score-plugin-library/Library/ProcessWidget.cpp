@@ -16,6 +16,7 @@
 #include <ossia/detail/math.hpp>
 
 #include <QApplication>
+#include <QDataStream>
 #include <QLabel>
 #include <QMainWindow>
 #include <QScrollArea>
@@ -255,15 +256,46 @@ void PresetLibraryHandler::setup(
 
 void PresetLibraryHandler::addPath(std::string_view path)
 {
+  addPathFromMetadata(path, readMetadata(path));
+}
+
+QByteArray PresetLibraryHandler::readMetadata(std::string_view path) const noexcept
+{
+  // The JSON is parsed here, so that the GUI thread only has to read
+  // the fields of the preset back
   QFile f{QString::fromUtf8(path.data(), path.length())};
+  if(!processes || !f.open(QIODevice::ReadOnly))
+    return {};
+
+  auto p = Process::Preset::fromJson(*processes, score::mapAsByteArray(f));
+  if(!p)
+    return {};
+
+  QByteArray res;
+  QDataStream s{&res, QIODevice::WriteOnly};
+  s << score::uuids::toByteArray(p->key.key.impl()) << p->key.effect << p->name
+    << p->data;
+  return res;
+}
 
-  if(!f.open(QIODevice::ReadOnly))
+void PresetLibraryHandler::addPathFromMetadata(
+    std::string_view path, const QByteArray& metadata)
+{
+  if(metadata.isEmpty())
     return;
 
-  if(auto p = Process::Preset::fromJson(*processes, score::mapAsByteArray(f)))
-  {
-    presetLib->addPreset(std::move(*p));
-  }
+  QByteArray uuid;
+  Process::Preset p;
+  QDataStream s{metadata};
+  s >> uuid >> p.key.effect >> p.name >> p.data;
+  if(s.status() != QDataStream::Ok)
+    return;
+
+  p.key.key = UuidKey<Process::ProcessModel>{uuid.begin(), uuid.end()};
+  if(!processes->get(p.key.key))
+    return;
+
+  presetLib->addPreset(std::move(p));
 }
 
 bool PresetLibraryHandler::onDrop(
@@ -38,6 +38,8 @@ public:
       override;
 
   void addPath(std::string_view path) override;
+  QByteArray readMetadata(std::string_view path) const noexcept override;
+  void addPathFromMetadata(std::string_view path, const QByteArray& metadata) override;
 
   bool onDrop(const QMimeData& mime, int row, int column, const QDir& parent) override;
 
@@ -5,18 +5,30 @@
 #include <Process/ProcessMimeSerialization.hpp>
 
 #include <Library/LibraryInterface.hpp>
+#include <Library/LibraryScanner.hpp>
 #include <Library/LibrarySettings.hpp>
 
 #include <score/application/GUIApplicationContext.hpp>
-#include <score/tools/RecursiveWatch.hpp>
+
+#include <ossia/detail/algorithms.hpp>
 
 #include <QElapsedTimer>
 #include <QIcon>
 #include <QMimeData>
-#include <QTimer>
+
+#include <algorithm>
 
 namespace Library
 {
+namespace
+{
+// Models notified of the nodes added through addToLibrary
+static std::vector<ProcessesItemModel*>& libraryModels()
+{
+  static std::vector<ProcessesItemModel*> models;
+  return models;
+}
+}
 
 ProcessesItemModel::ProcessesItemModel(
     const score::GUIApplicationContext& ctx, QObject* parent)
@@ -25,6 +37,7 @@ ProcessesItemModel::ProcessesItemModel(
 {
   auto& procs = ctx.interfaces<Process::ProcessFactoryList>();
   procs.added.connect<&ProcessesItemModel::on_newPlugin>(*this);
+  libraryModels().push_back(this);
 
   auto& lib = context.settings<Library::Settings::Model>();
   con(lib, &Library::Settings::Model::rescanLibrary, this, &ProcessesItemModel::rescan);
@@ -63,8 +76,36 @@ ProcessNode& ProcessesItemModel::addCategory(const QString& c)
   return *node;
 }
 
+ProcessesItemModel::~ProcessesItemModel()
+{
+  ossia::remove_erase(libraryModels(), this);
+}
+
+ProcessesItemModel* ProcessesItemModel::modelOf(const ProcessNode& node) noexcept
+{
+  auto root = &node;
+  while(root->parent())
+    root = root->parent();
+
+  for(auto* model : libraryModels())
+    if(&model->m_root == root)
+      return model;
+  return nullptr;
+}
+
+QModelIndex ProcessesItemModel::indexOf(const ProcessNode& node) const noexcept
+{
+  auto parent = node.parent();
+  if(!parent)
+    return {};
+  return createIndex(parent->indexOfChild(&node), 0, &node);
+}
+
 void ProcessesItemModel::rescan()
 {
+  // Batches of a scan still in progress refer to the nodes which are removed here
+  m_scanner.reset();
+
   auto& procs = context.interfaces<Process::ProcessFactoryList>();
 
   ossia::flat_map<QString, std::vector<Process::ProcessModelFactory*>> sorted;
@@ -97,25 +138,24 @@ void ProcessesItemModel::rescan()
 
   auto libpath = lib.getPackagesPath();
 
-  static score::RecursiveWatch w;
-  w.reset();
-  w.setWatchedFolder(libpath.toStdString());
   auto& lib_setup = context.interfaces<Library::LibraryInterfaceList>();
   // TODO lib_setup.added.connect<&ProcessesItemModel::on_newPlugin>(*this);
+  std::vector<LibraryInterface*> handlers;
   for(auto& lib : lib_setup)
   {
     lib.setup(*this, context);
-    score::RecursiveWatch::Callbacks cbs;
-    cbs.added = [&lib](std::string_view path) { lib.addPath(path); };
-    cbs.removed = [&lib](std::string_view path) { lib.removePath(path); };
-    for(const QString& ext : lib.acceptedFiles())
-      w.registerWatch(ext.toStdString(), cbs);
+    handlers.push_back(&lib);
   }
 
   if(!QDir{libpath}.exists())
     return;
 
-  QTimer::singleShot(1, this, [] { w.scan(); });
+  m_scanner = std::make_unique<LibraryScanner>(
+      libpath, handlers, this, [this](LibraryScanner::Batch& batch) {
+    // The views are notified of each node by addToLibrary
+    for(auto& file : batch)
+      file.handler->addPathFromMetadata(file.path, file.metadata);
+  });
 }
 
 void ProcessesItemModel::on_newPlugin(const Process::ProcessModelFactory& fact)
@@ -254,8 +294,20 @@ ProcessNode& addToLibrary(ProcessNode& parent, ProcessData&& data)
       return QString::compare(lhs.prettyName, rhs, Qt::CaseInsensitive) < 0;
     }
   } nameSort;
-  return ossia::emplace_sorted(
-      parent, data.prettyName, nameSort, std::move(data), &parent);
+  auto it = std::upper_bound(parent.begin(), parent.end(), data.prettyName, nameSort);
+
+  auto model = ProcessesItemModel::modelOf(parent);
+  if(model)
+  {
+    const int row = std::distance(parent.begin(), it);
+    model->beginInsertRows(model->indexOf(parent), row, row);
+  }
+
+  auto& node = parent.emplace(it, std::move(data), &parent);
+
+  if(model)
+    model->endInsertRows();
+  return node;
 }
 
 }
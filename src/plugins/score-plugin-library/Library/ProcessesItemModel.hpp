@@ -28,6 +28,7 @@ struct GUIApplicationContext;
 
 namespace Library
 {
+class LibraryScanner;
 struct ProcessData : Process::ProcessData
 {
   QIcon icon;
@@ -51,6 +52,7 @@ public:
   using QAbstractItemModel::endRemoveRows;
 
   ProcessesItemModel(const score::GUIApplicationContext& ctx, QObject* parent);
+  ~ProcessesItemModel() override;
 
   void rescan();
   QModelIndex find(const Process::ProcessModelFactory::ConcreteKey& k);
@@ -73,9 +75,14 @@ public:
   void on_newPlugin(const Process::ProcessModelFactory& fact);
 
 private:
+  friend ProcessNode& addToLibrary(ProcessNode& parent, Library::ProcessData&& data);
+  static ProcessesItemModel* modelOf(const ProcessNode& node) noexcept;
+  QModelIndex indexOf(const ProcessNode& node) const noexcept;
+
   ProcessNode& addCategory(const QString& cat);
   const score::GUIApplicationContext& context;
   ProcessNode m_root;
+  std::unique_ptr<LibraryScanner> m_scanner;
 };
 
 /** Utility class to organize a library in subcategories that depend
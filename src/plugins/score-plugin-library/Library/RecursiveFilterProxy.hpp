@@ -2,6 +2,7 @@
 #include <score/tools/Debug.hpp>
 
 #include <QFileSystemModel>
+#include <QHash>
 #include <QSortFilterProxyModel>
 
 namespace Library
@@ -15,17 +16,54 @@ public:
   void setPattern(const QString& p)
   {
     beginResetModel();
-    auto old = m_textPattern;
     m_textPattern = p;
+    clearMatches();
     endResetModel();
-    // if(!p.contains(old))
-    //  invalidateFilter();
+  }
+
+  void setSourceModel(QAbstractItemModel* model) override
+  {
+    if(auto old = sourceModel())
+      disconnect(old, nullptr, this, nullptr);
+
+    // Connected before the handlers of QSortFilterProxyModel, so that the
+    // cached matches are discarded before it filters the source rows again.
+    if(model)
+    {
+      using M = QAbstractItemModel;
+      const auto clear = [this] { clearMatches(); };
+      connect(model, &M::modelAboutToBeReset, this, clear);
+      connect(model, &M::layoutAboutToBeChanged, this, clear);
+      connect(model, &M::rowsAboutToBeInserted, this, clear);
+      connect(model, &M::rowsInserted, this, clear);
+      connect(model, &M::rowsAboutToBeRemoved, this, clear);
+      connect(model, &M::rowsRemoved, this, clear);
+      connect(model, &M::rowsAboutToBeMoved, this, clear);
+      connect(model, &M::dataChanged, this, clear);
+    }
+    QSortFilterProxyModel::setSourceModel(model);
   }
 
 protected:
   QString m_textPattern;
+
+  // Each row of the source is only matched once per pattern:
+  // without this, every row is checked again for each of its parents
+  // and children, which is quadratic in the size of the library.
+  mutable QHash<QModelIndex, bool> m_selfMatches;
+  mutable QHash<QModelIndex, bool> m_childrenMatches;
+
+  void clearMatches()
+  {
+    m_selfMatches.clear();
+    m_childrenMatches.clear();
+  }
+
   bool filterAcceptsRow(int srcRow, const QModelIndex& srcParent) const override
   {
+    if(m_textPattern.isEmpty())
+      return true;
+
     if(filterAcceptsRowItself(srcRow, srcParent))
     {
       return true;
@@ -45,9 +83,13 @@ protected:
   bool filterAcceptsRowItself(int srcRow, const QModelIndex& srcParent) const
   {
     QModelIndex index = sourceModel()->index(srcRow, 0, srcParent);
-    const QVariant& data = sourceModel()->data(index);
+    if(auto it = m_selfMatches.constFind(index); it != m_selfMatches.cend())
+      return *it;
 
-    return data.toString().contains(m_textPattern, Qt::CaseInsensitive);
+    const QVariant& data = sourceModel()->data(index);
+    const bool res = data.toString().contains(m_textPattern, Qt::CaseInsensitive);
+    m_selfMatches.insert(index, res);
+    return res;
   }
 
   bool hasAcceptedChildren(int srcRow, const QModelIndex& srcParent) const
@@ -57,22 +99,20 @@ protected:
     if(!index.isValid())
       return false;
 
+    if(auto it = m_childrenMatches.constFind(index); it != m_childrenMatches.cend())
+      return *it;
+
     SCORE_ASSERT(index.model());
     const int childCount = index.model()->rowCount(index);
 
-    if(childCount == 0)
-      return false;
-
-    for(int i = 0; i < childCount; ++i)
+    bool res = false;
+    for(int i = 0; i < childCount && !res; ++i)
     {
-      if(filterAcceptsRowItself(i, index))
-        return true;
-
-      if(hasAcceptedChildren(i, index))
-        return true;
+      res = filterAcceptsRowItself(i, index) || hasAcceptedChildren(i, index);
     }
 
-    return false;
+    m_childrenMatches.insert(index, res);
+    return res;
   }
 };
 
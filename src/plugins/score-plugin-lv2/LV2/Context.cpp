@@ -113,7 +113,7 @@ struct worker
     auto& self = *(worker*)sub_h;
     auto response_data = self.host->acquire_worker_data((const char*)sub_d, sub_s);
 
-    self.fx->worker_datas.enqueue(std::move(response_data));
+    self.fx->worker_datas.enqueue(self.fx->worker_token, std::move(response_data));
 
     return LV2_WORKER_SUCCESS;
   }
@@ -134,8 +134,9 @@ do_worker(LV2_Worker_Schedule_Handle ptr, uint32_t s, const void* data)
       std::vector<char> cp = c.host.acquire_worker_data((const char*)data, s);
 
       // 2. Move that buffer to the thread pool
-      auto& tq = score::TaskPool::instance();
-      tq.post(worker{.host = &c.host, .fx = cur, .dat = std::move(cp)});
+      cur->worker_strand.post(
+          worker{.host = &c.host, .fx = cur, .dat = std::move(cp)},
+          score::TaskPool::Priority::High);
 
       return LV2_WORKER_SUCCESS;
     }
@@ -23,6 +23,8 @@
 #include <lv2/lv2plug.in/ns/ext/worker/worker.h>
 #include <lv2/lv2plug.in/ns/extensions/ui/ui.h>
 
+#include <score/tools/ThreadPool.hpp>
+
 #include <ossia/detail/hash_map.hpp>
 #include <ossia/detail/lockfree_queue.hpp>
 #include <ossia/detail/small_vector.hpp>
@@ -142,6 +144,11 @@ struct EffectContext
   SuilInstance* ui_instance{};
 
   ossia::mpmc_queue<std::vector<char>> worker_datas;
+
+  // The requests of a plug-in run one after the other, in order.
+  // The responses keep that order as they are only sent from the strand.
+  score::TaskPool::Strand worker_strand{score::TaskPool::instance()};
+  moodycamel::ProducerToken worker_token{worker_datas};
 };
 
 struct GlobalContext
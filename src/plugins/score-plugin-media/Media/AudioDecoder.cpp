@@ -4,6 +4,7 @@
 #include <Media/Sound/SoundModel.hpp>
 
 #include <score/tools/Debug.hpp>
+#include <score/tools/ThreadPool.hpp>
 
 #include <ossia/dataflow/sample_to_float.hpp>
 #include <ossia/detail/libav.hpp>
@@ -379,9 +380,9 @@ AudioDecoder::AudioDecoder(int rate)
 
 AudioDecoder::~AudioDecoder()
 {
-  m_decodeThread.exit();
-  while(m_decodeThread.isRunning())
-    ;
+  m_decoding.wait(true);
+  if(m_decodeThread)
+    score::ThreadPool::instance().releaseThread();
 }
 
 struct AVCodecContext_Free
@@ -562,8 +563,11 @@ void AudioDecoder::decode(const QString& path, int trackToUse, audio_handle hdl)
   if(data.size() == 0)
     return;
 
-  this->moveToThread(&m_decodeThread);
-  m_decodeThread.start();
+  if(!m_decodeThread)
+    m_decodeThread = score::ThreadPool::instance().acquireThread();
+  m_baseThread = this->thread();
+  m_decoding = true;
+  this->moveToThread(m_decodeThread);
   startDecode(path, hdl);
 #endif
 }
@@ -865,7 +869,12 @@ void AudioDecoder::on_startDecode(QString path, audio_handle hdl)
   }
 
   finishedDecoding(hdl);
-  m_decodeThread.quit();
+
+  // Give the pool thread back
+  if(m_baseThread)
+    this->moveToThread(m_baseThread);
+  m_decoding = false;
+  m_decoding.notify_all();
 
 #endif
   return;
@@ -67,8 +67,10 @@ public:
 private:
   static double read_length(const QString& path);
 
+  // Decoding happens on one of the threads of score::ThreadPool
   QThread* m_baseThread{};
-  QThread m_decodeThread;
+  QThread* m_decodeThread{};
+  std::atomic_bool m_decoding{};
 
   template <typename Decoder>
   void decodeFrame(Decoder dec, audio_array& data, AVFrame& frame);
@@ -0,0 +1,263 @@
+#include "AudioPrefetcher.hpp"
+
+#include <ossia/detail/algorithms.hpp>
+#include <ossia/detail/thread.hpp>
+
+#include <algorithm>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace Media
+{
+namespace
+{
+static constexpr int64_t page_size = 4096;
+static constexpr int64_t default_budget = 256 * 1024 * 1024;
+
+// Even with a large budget, there is no point in reading further than this
+static constexpr int64_t max_readahead_seconds = 10;
+
+// The playhead is estimated from the GUI: the pages just behind it are kept
+// in case the audio thread is still reading them, e.g. when the tempo changes
+static constexpr int64_t keep_behind_seconds = 2;
+
+static constexpr int64_t page_floor(int64_t v) noexcept
+{
+  return v & ~(page_size - 1);
+}
+static constexpr int64_t page_ceil(int64_t v) noexcept
+{
+  return page_floor(v + page_size - 1);
+}
+
+static void touch(const char* data, int64_t begin, int64_t end) noexcept
+{
+  // Reading one byte per page is enough to fault it in from this thread
+  volatile char sink{};
+  for(int64_t i = page_floor(begin); i < end; i += page_size)
+    sink = data[i];
+  (void)sink;
+}
+
+static void release(const char* data, int64_t begin, int64_t end) noexcept
+{
+#if defined(__linux__)
+  // Only the pages which are entirely in the range are released
+  begin = page_ceil(begin);
+  end = page_floor(end);
+  if(end > begin)
+    ::madvise(const_cast<char*>(data) + begin, end - begin, MADV_DONTNEED);
+#endif
+}
+
+using Range = AudioPrefetcher::Clip::Range;
+
+// Releases the parts of [begin, end) which are not in a kept range.
+// keep is sorted by beginning.
+static void release(
+    const char* data, Range r, const std::vector<Range>& keep) noexcept
+{
+  int64_t cur = r.begin;
+  for(const auto& k : keep)
+  {
+    if(k.begin >= r.end)
+      break;
+    if(k.end <= cur)
+      continue;
+    release(data, cur, k.begin);
+    cur = std::max(cur, k.end);
+  }
+  release(data, cur, r.end);
+}
+}
+
+AudioPrefetcher& AudioPrefetcher::instance() noexcept
+{
+  static AudioPrefetcher prefetcher;
+  return prefetcher;
+}
+
+AudioPrefetcher::AudioPrefetcher()
+    : m_budget{default_budget}
+{
+}
+
+AudioPrefetcher::~AudioPrefetcher()
+{
+  {
+    std::lock_guard lck{m_mutex};
+    m_running = false;
+  }
+  m_condVar.notify_one();
+
+  if(m_thread.joinable())
+    m_thread.join();
+}
+
+std::shared_ptr<AudioPrefetcher::Clip> AudioPrefetcher::add(
+    std::shared_ptr<QFile> file, const char* data, int64_t bytes, int64_t dataOffset,
+    int64_t frameBytes, int64_t rate)
+{
+  auto clip = std::make_shared<Clip>();
+  clip->file = std::move(file);
+  clip->data = data;
+  clip->bytes = bytes;
+  clip->dataOffset = dataOffset;
+  clip->frameBytes = frameBytes;
+  clip->rate = rate;
+
+  std::lock_guard lck{m_mutex};
+  m_clips.push_back(clip);
+
+  if(!m_thread.joinable())
+  {
+    m_running = true;
+    m_thread = std::thread{[this] {
+      ossia::set_thread_name("ossia audio prefetch");
+      this->run();
+    }};
+  }
+  return clip;
+}
+
+void AudioPrefetcher::remove(const std::shared_ptr<Clip>& clip)
+{
+  // The clip stays in the list until the I/O thread has released its pages
+  clip->removed = true;
+  {
+    std::lock_guard lck{m_mutex};
+    m_dirty = true;
+  }
+  m_condVar.notify_one();
+}
+
+void AudioPrefetcher::seek(
+    Clip& clip, int64_t playhead, int64_t loopStart, int64_t loopEnd)
+{
+  clip.loopStart = loopStart;
+  clip.loopEnd = loopEnd;
+  clip.playhead = std::max(int64_t(0), playhead);
+  {
+    std::lock_guard lck{m_mutex};
+    m_dirty = true;
+  }
+  m_condVar.notify_one();
+}
+
+void AudioPrefetcher::setBudget(int64_t bytes) noexcept
+{
+  m_budget = std::max(int64_t(0), bytes);
+  {
+    std::lock_guard lck{m_mutex};
+    m_dirty = true;
+  }
+  m_condVar.notify_one();
+}
+
+void AudioPrefetcher::run()
+{
+  std::vector<std::shared_ptr<Clip>> clips;
+  for(;;)
+  {
+    {
+      std::unique_lock lck{m_mutex};
+      // Playing clips are moved forward by seek, so there is nothing to do
+      // until something changes
+      m_condVar.wait(lck, [this] { return m_dirty || !m_running; });
+      if(!m_running)
+        return;
+      m_dirty = false;
+      clips = m_clips;
+    }
+
+    const int64_t playing = std::count_if(clips.begin(), clips.end(), [](auto& c) {
+      return !c->removed && c->playhead.load(std::memory_order_relaxed) >= 0;
+    });
+    const int64_t share = m_budget.load() / std::max(int64_t(1), playing);
+
+    for(auto& clip : clips)
+    {
+      const int64_t window
+          = std::min(share, max_readahead_seconds * clip->rate * clip->frameBytes);
+      prefetch(*clip, window);
+    }
+
+    // Once every window is known, since clips can share a mapping
+    for(auto& clip : clips)
+      release(*clip, clips);
+
+    {
+      // Removed clips have been released at this point
+      std::lock_guard lck{m_mutex};
+      for(auto& clip : clips)
+        if(clip->removed)
+          ossia::remove_erase(m_clips, clip);
+    }
+    clips.clear();
+  }
+}
+
+void AudioPrefetcher::prefetch(Clip& clip, int64_t window) noexcept
+{
+  const int64_t head = clip.playhead.load(std::memory_order_relaxed);
+  clip.wanted = {};
+  if(head < 0 || clip.removed)
+    return;
+
+  const int64_t begin = std::min(
+      page_floor(clip.dataOffset + head * clip.frameBytes), clip.bytes);
+  int64_t end = std::min(begin + window, clip.bytes);
+  const int64_t behind = page_floor(std::max(
+      clip.dataOffset, begin - keep_behind_seconds * clip.rate * clip.frameBytes));
+
+  // Nothing past the end of the loop will be read
+  const int64_t loopEnd = clip.loopEnd.load(std::memory_order_relaxed);
+  const int64_t loopEndByte = clip.dataOffset + loopEnd * clip.frameBytes;
+  if(loopEnd > head && loopEndByte < end)
+  {
+    end = loopEndByte;
+
+    // The beginning of the loop gets the rest of the window
+    const int64_t loopBegin = clip.dataOffset
+                              + clip.loopStart.load(std::memory_order_relaxed)
+                                    * clip.frameBytes;
+    const int64_t remaining = window - (end - begin);
+    const Range loop{loopBegin, std::min(loopBegin + remaining, clip.bytes)};
+    touch(clip.data, loop.begin, loop.end);
+    clip.wanted[1] = loop;
+  }
+
+  // When playing forward only the new pages need to be read ;
+  // after a seek the whole window is.
+  const auto& old = clip.resident[0];
+  if(begin >= old.begin && begin <= old.end)
+    touch(clip.data, std::max(begin, old.end), end);
+  else
+    touch(clip.data, begin, end);
+
+  clip.wanted[0] = {behind, end};
+}
+
+void AudioPrefetcher::release(
+    Clip& clip, const std::vector<std::shared_ptr<Clip>>& clips)
+{
+  // What this clip and the other clips of the same mapping still want
+  std::vector<Range> keep;
+  for(auto& other : clips)
+    if(other->data == clip.data)
+      for(const auto& r : other->wanted)
+        if(r.end > r.begin)
+          keep.push_back(r);
+  std::sort(keep.begin(), keep.end(), [](const Range& lhs, const Range& rhs) {
+    return lhs.begin < rhs.begin;
+  });
+
+  for(const auto& r : clip.resident)
+    if(r.end > r.begin)
+      Media::release(clip.data, r, keep);
+
+  clip.resident = clip.wanted;
+}
+}
@@ -0,0 +1,92 @@
+#pragma once
+#include <QFile>
+
+#include <score_plugin_media_export.h>
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Media
+{
+/**
+ * @brief Reads ahead of the playhead of memory-mapped sound files.
+ *
+ * Memory-mapped files are read directly from the audio thread: without
+ * read-ahead, every page it touches for the first time is a major page fault.
+ *
+ * A background thread keeps a window ahead of the playhead of each playing
+ * clip resident (as well as the beginning of the loop when the window crosses
+ * the loop end), and releases the pages which were played a while ago, so
+ * that the memory used by all the clips together stays within a global budget.
+ * Pages still wanted by another clip of the same mapping are not released.
+ * The thread only wakes up when a clip is moved, added or removed.
+ */
+class SCORE_PLUGIN_MEDIA_EXPORT AudioPrefetcher
+{
+public:
+  struct Clip
+  {
+    // Keeps the mapping alive while the I/O thread reads it
+    std::shared_ptr<QFile> file;
+    const char* data{};
+    int64_t bytes{};
+
+    int64_t dataOffset{};
+    int64_t frameBytes{};
+    int64_t rate{};
+
+    // In frames. Written by the GUI thread, read by the I/O thread.
+    // A negative playhead means that the clip is not playing.
+    std::atomic_int64_t playhead{-1};
+    std::atomic_int64_t loopStart{};
+    std::atomic_int64_t loopEnd{-1};
+    std::atomic_bool removed{};
+
+    // Only accessed by the I/O thread: ranges of bytes currently kept
+    // resident, ahead of the playhead and at the beginning of the loop
+    struct Range
+    {
+      int64_t begin{};
+      int64_t end{};
+    };
+    std::array<Range, 2> resident{};
+    std::array<Range, 2> wanted{};
+  };
+
+  static AudioPrefetcher& instance() noexcept;
+
+  std::shared_ptr<Clip> add(
+      std::shared_ptr<QFile> file, const char* data, int64_t bytes,
+      int64_t dataOffset, int64_t frameBytes, int64_t rate);
+  void remove(const std::shared_ptr<Clip>& clip);
+
+  //! Called on transport changes (start, seek, loop) and while playing
+  void seek(Clip& clip, int64_t playhead, int64_t loopStart, int64_t loopEnd);
+
+  void setBudget(int64_t bytes) noexcept;
+  int64_t budget() const noexcept { return m_budget; }
+
+private:
+  AudioPrefetcher();
+  ~AudioPrefetcher();
+
+  void run();
+  void prefetch(Clip& clip, int64_t window) noexcept;
+  void release(Clip& clip, const std::vector<std::shared_ptr<Clip>>& clips);
+
+  std::vector<std::shared_ptr<Clip>> m_clips;
+  std::thread m_thread;
+  std::mutex m_mutex;
+  std::condition_variable m_condVar;
+  bool m_dirty{};
+  bool m_running{};
+
+  std::atomic_int64_t m_budget;
+};
+}
@@ -0,0 +1,109 @@
+#include <Media/MediaFileHandle.hpp>
+
+#include <score/tools/ThreadPool.hpp>
+
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QStandardPaths>
+
+#include <algorithm>
+#include <atomic>
+
+namespace Media
+{
+// Bump when the layout of the cached files changes
+static constexpr int decoded_cache_version = 2;
+
+// The least recently used files are removed past this size
+static constexpr qint64 decoded_cache_max_bytes = 4LL * 1024 * 1024 * 1024;
+
+static QString decodedCacheFolder()
+{
+  const auto cache
+      = QStandardPaths::writableLocation(QStandardPaths::StandardLocation::CacheLocation);
+  if(cache.isEmpty())
+    return {};
+
+  QDir cache_dir{cache};
+  if(!cache_dir.mkpath("decoded") || !cache_dir.cd("decoded"))
+    return {};
+  return cache_dir.absolutePath();
+}
+
+// Removes the least recently used files until the folder fits in the limit
+static void trimDecodedCache(const QString& folder)
+{
+  QDir dir{folder};
+  auto files = dir.entryInfoList({"*.wav"}, QDir::Files, QDir::Time | QDir::Reversed);
+
+  qint64 total = 0;
+  for(const auto& f : files)
+    total += f.size();
+
+  for(const auto& f : files)
+  {
+    if(total <= decoded_cache_max_bytes)
+      break;
+    if(QFile::remove(f.absoluteFilePath()))
+      total -= f.size();
+  }
+}
+
+QString decodedCachePath(const QString& absolutePath, int rate)
+{
+  // Only file metadata is used: this runs on the GUI thread for every load
+  const QFileInfo info{absolutePath};
+  const QString canonical = info.canonicalFilePath();
+  if(canonical.isEmpty())
+    return {};
+
+  const auto folder = decodedCacheFolder();
+  if(folder.isEmpty())
+    return {};
+
+  QCryptographicHash h{QCryptographicHash::Sha1};
+  h.addData(QByteArray::number(decoded_cache_version));
+  h.addData(QByteArray::number(rate));
+  h.addData(canonical.toUtf8());
+  h.addData(QByteArray::number(info.size()));
+  h.addData(QByteArray::number(info.lastModified().toMSecsSinceEpoch()));
+
+  return folder + QStringLiteral("/") + QString::fromLatin1(h.result().toHex())
+         + QStringLiteral(".wav");
+}
+
+void markDecodedCacheUsed(const QString& cachePath)
+{
+  QFile f{cachePath};
+  if(f.open(QIODevice::ReadWrite))
+    f.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+}
+
+void storeInDecodedCache(const QString& absolutePath, int rate, ossia::audio_handle data)
+{
+  if(!data || data->data.empty())
+    return;
+
+  auto path = decodedCachePath(absolutePath, rate);
+  if(path.isEmpty() || QFile::exists(path))
+    return;
+
+  score::TaskPool::instance().post([path = std::move(path), rate, data] {
+    // Written under a unique temporary name so that a partial file is never
+    // picked up, and that concurrent stores of a same file do not collide
+    static std::atomic_int counter{};
+    const auto pid = QString::number(QCoreApplication::applicationPid());
+    const QString tmp
+        = QStringLiteral("%1.%2.%3.tmp").arg(path, pid, QString::number(counter++));
+    writeAudioArrayToFile(tmp, data->data, rate);
+    if(!QFile::rename(tmp, path))
+      QFile::remove(tmp);
+
+    trimDecodedCache(QFileInfo{path}.absolutePath());
+  }, score::TaskPool::Priority::Low);
+}
+}
@@ -18,6 +18,7 @@
 #include <ossia/detail/ssize.hpp>
 
 #include <QDebug>
+#include <QFile>
 #include <QFileInfo>
 #include <QRegularExpression>
 
@@ -84,13 +85,19 @@ void AudioFile::load(DecodingSetup opt)
   switch(opt.method)
   {
     case DecodingMethod::Libav:
-      load_libav(rate);
+      if(!load_cached(rate))
+        load_libav(rate);
       break;
     case DecodingMethod::Mmap:
-      load_drwav();
+      if(!load_drwav(m_file))
+      {
+        m_impl = Handle{};
+        on_mediaChanged();
+      }
       break;
     case DecodingMethod::Sndfile:
-      load_sndfile();
+      if(!load_cached(rate))
+        load_sndfile();
       break;
     case DecodingMethod::LibavStream:
       // FIXME
@@ -103,6 +110,26 @@ void AudioFile::load(DecodingSetup opt)
   }
 }
 
+bool AudioFile::load_cached(int rate)
+{
+  // Only the default track is cached
+  if(m_track != -1)
+    return false;
+
+  const auto cached = decodedCachePath(m_file, rate);
+  if(cached.isEmpty() || !QFile::exists(cached))
+    return false;
+
+  if(load_drwav(cached))
+  {
+    markDecodedCacheUsed(cached);
+    return true;
+  }
+
+  QFile::remove(cached);
+  return false;
+}
+
 int64_t AudioFile::decodedSamples() const
 {
   struct
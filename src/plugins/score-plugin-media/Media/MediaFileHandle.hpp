@@ -231,7 +231,8 @@ public:
 private:
   void load_libav(int rate);
   void load_libav_stream();
-  void load_drwav();
+  bool load_drwav(const QString& path);
+  bool load_cached(int rate);
   void load_sndfile();
 
   friend class SoundComponentSetup;
@@ -290,6 +291,27 @@ private:
 SCORE_PLUGIN_MEDIA_EXPORT
 void writeAudioArrayToFile(const QString& path, const ossia::audio_array& arr, int fs);
 
+/**
+ * @brief Location of the decoded copy of an audio file in the user cache.
+ *
+ * Files which need decoding (compressed formats, AIFF, or a sample rate
+ * different from the audio settings) are stored there once decoded, as 32-bit
+ * float .wav at the target rate, so that the next loads can memory-map and
+ * stream them directly instead of keeping them in RAM.
+ * The key is made of the canonical path, size and modification date of the
+ * file and of the rate. The cache is bounded: the least recently used files
+ * are removed first.
+ *
+ * Returns an empty string if the file or the cache folder cannot be accessed.
+ */
+QString decodedCachePath(const QString& absolutePath, int rate);
+
+//! Keeps a cached file from being the next one removed.
+void markDecodedCacheUsed(const QString& cachePath);
+
+//! Writes the decoded data to the cache from a background thread.
+void storeInDecodedCache(const QString& absolutePath, int rate, ossia::audio_handle data);
+
 std::optional<double> estimateTempo(const AudioFile& file);
 std::optional<double> estimateTempo(const QString& filePath);
 
@@ -64,6 +64,10 @@ void AudioFile::load_libav(int rate)
         }
         m_rms->decodeLast(samples);
 
+        // Files which failed to decode entirely are not cached
+        if(m_track == -1 && !handle.empty() && decoded == handle[0].size())
+          storeInDecodedCache(m_file, m_sampleRate, r.handle);
+
         m_fullyDecoded = true;
         on_finishedDecoding();
           },
@@ -9,38 +9,36 @@
 
 namespace Media
 {
-void AudioFile::load_drwav()
+bool AudioFile::load_drwav(const QString& path)
 {
-  qDebug() << "AudioFileHandle::load_drwav(): " << m_file;
+  qDebug() << "AudioFileHandle::load_drwav(): " << path;
 
   // Loading with drwav is done when the file can be
   // mmapped directly in to memory.
+  // path is either m_file or its decoded copy in the cache.
 
   MmapReader r;
   r.file = std::make_shared<QFile>();
-  r.file->setFileName(m_file);
+  r.file->setFileName(path);
 
   bool ok = r.file->open(QIODevice::ReadOnly);
   if(!ok)
   {
-    qDebug() << "Cannot open file" << m_file;
-    m_impl = Handle{};
-    on_mediaChanged();
+    qDebug() << "Cannot open file" << path;
+    return false;
   }
 
   r.data = r.file->map(0, r.file->size());
   if(!r.data)
   {
-    qDebug() << "Cannot open file" << m_file;
-    m_impl = Handle{};
-    on_mediaChanged();
+    qDebug() << "Cannot open file" << path;
+    return false;
   }
   r.wav.open_memory(r.data, r.file->size());
   if(!r.wav || r.wav.channels() == 0 || r.wav.sampleRate() == 0)
   {
-    qDebug() << "Cannot open file" << m_file;
-    m_impl = Handle{};
-    on_mediaChanged();
+    qDebug() << "Cannot open file" << path;
+    return false;
   }
 
   m_rms->load(
@@ -52,7 +50,7 @@ void AudioFile::load_drwav()
     m_rms->decode(r.wav);
   }
 
-  QFileInfo fi{*r.file};
+  QFileInfo fi{m_file};
   m_fileName = fi.fileName();
   m_sampleRate = r.wav.sampleRate();
 
@@ -62,6 +60,7 @@ void AudioFile::load_drwav()
   on_mediaChanged();
   on_finishedDecoding();
   qDebug() << "AudioFileHandle::on_mediaChanged(): " << m_file;
+  return true;
 }
 
 std::optional<AudioInfo> probe_drwav(const QFileInfo& fi)
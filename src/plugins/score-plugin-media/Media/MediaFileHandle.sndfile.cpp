@@ -29,6 +29,9 @@ void AudioFile::load_sndfile()
 
   m_rms->newData();
   m_rms->finishedDecoding();
+
+  if(!r.handle->data.empty() && r.decoder.decoded == r.handle->data[0].size())
+    storeInDecodedCache(m_file, r.decoder.fileSampleRate, r.handle);
   /* FIXME
   if (!m_rms->exists())
   {
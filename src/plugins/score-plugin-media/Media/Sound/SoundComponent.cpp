@@ -4,8 +4,11 @@
 #include <Process/ExecutionSetup.hpp>
 #include <Process/ExecutionTransaction.hpp>
 
+#include <Scenario/Document/Interval/IntervalModel.hpp>
 #include <Scenario/Execution/score2OSSIA.hpp>
 
+#include <Media/Tempo.hpp>
+
 #include <score/tools/Bind.hpp>
 
 #include <ossia/dataflow/execution_state.hpp>
@@ -16,6 +19,8 @@
 #include <ossia/dataflow/nodes/sound_ref.hpp>
 #include <ossia/detail/pod_vector.hpp>
 
+#include <cmath>
+
 namespace
 {
 
@@ -67,6 +72,7 @@ public:
         update_ref(node, r, component, commands);
 
         commands.run_all();
+        component.setPrefetch(nullptr);
       }
       void operator()(const Media::AudioFile::LibavStreamReader& r) const noexcept
       {
@@ -79,6 +85,7 @@ public:
         update_libav(node, r, component, commands);
 
         commands.run_all();
+        component.setPrefetch(nullptr);
       }
       void operator()(const Media::AudioFile::SndfileReader& r) const noexcept
       {
@@ -91,6 +98,7 @@ public:
         update_sndfile(node, r, component, commands);
 
         commands.run_all();
+        component.setPrefetch(nullptr);
       }
       void operator()(const Media::AudioFile::MmapReader& r) const noexcept
       {
@@ -103,6 +111,7 @@ public:
         update_mmap(node, r, component, commands);
 
         commands.run_all();
+        component.setPrefetch(&r);
       }
     } _{component};
 
@@ -117,7 +126,10 @@ public:
     struct
     {
       Execution::SoundComponent& component;
-      void operator()(ossia::monostate) const noexcept { return; }
+      void operator()(ossia::monostate) const noexcept
+      {
+        component.setPrefetch(nullptr);
+      }
 
       void replace_node(
           const std::shared_ptr<ossia::graph_node>& old_node,
@@ -150,6 +162,7 @@ public:
         }
 
         commands.run_all();
+        component.setPrefetch(nullptr);
       }
       void operator()(const Media::AudioFile::LibavStreamReader& r) const noexcept
       {
@@ -169,6 +182,7 @@ public:
         }
 
         commands.run_all();
+        component.setPrefetch(nullptr);
       }
       void operator()(const Media::AudioFile::SndfileReader& r) const noexcept
       {
@@ -188,6 +202,7 @@ public:
         }
 
         commands.run_all();
+        component.setPrefetch(nullptr);
       }
       void operator()(const Media::AudioFile::MmapReader& r) const noexcept
       {
@@ -210,6 +225,7 @@ public:
         }
 
         commands.run_all();
+        component.setPrefetch(&r);
       }
     } _{component};
 
@@ -337,6 +353,23 @@ SoundComponent::SoundComponent(
     });
   });
 
+  // Follow the transport so that the file is read ahead of the playhead
+  if(auto itv = qobject_cast<Scenario::IntervalModel*>(element.parent()))
+  {
+    con(itv->duration, &Scenario::IntervalDurations::playPercentageChanged, this,
+        &SoundComponent::seekPrefetch);
+  }
+  con(element, &Process::ProcessModel::startOffsetChanged, this,
+      &SoundComponent::seekPrefetch);
+  con(element, &Process::ProcessModel::loopsChanged, this,
+      &SoundComponent::seekPrefetch);
+  con(element, &Process::ProcessModel::loopDurationChanged, this,
+      &SoundComponent::seekPrefetch);
+  con(element, &Media::Sound::ProcessModel::nativeTempoChanged, this,
+      &SoundComponent::seekPrefetch);
+  con(element, &Media::Sound::ProcessModel::stretchModeChanged, this,
+      &SoundComponent::seekPrefetch);
+
   if(auto& file = element.file())
   {
     file->on_finishedDecoding.connect<&SoundComponent::Recomputer::recompute>(
@@ -371,5 +404,71 @@ void SoundComponent::recompute()
   Media::SoundComponentSetup{}.update(*this);
 }
 
-SoundComponent::~SoundComponent() { }
+void SoundComponent::setPrefetch(const Media::AudioFile::MmapReader* r)
+{
+  auto& prefetcher = Media::AudioPrefetcher::instance();
+  if(m_prefetch)
+  {
+    prefetcher.remove(m_prefetch);
+    m_prefetch.reset();
+  }
+
+  if(!r || !r->data || !r->wav)
+    return;
+
+  const auto* wav = r->wav.wav();
+  m_prefetch = prefetcher.add(
+      r->file, static_cast<const char*>(r->data), r->file->size(),
+      wav->dataChunkDataPos, wav->fmt.blockAlign, wav->sampleRate);
+  seekPrefetch();
+}
+
+void SoundComponent::seekPrefetch()
+{
+  if(!m_prefetch)
+    return;
+
+  auto& proc = process();
+
+  // Time elapsed in the process, computed like in IntervalComponent::slot_callback
+  double elapsed = 0.;
+  if(auto itv = qobject_cast<Scenario::IntervalModel*>(proc.parent()))
+  {
+    const auto& dur = itv->duration;
+    const auto& ref
+        = dur.maxDuration().infinite() ? dur.defaultDuration() : dur.maxDuration();
+    elapsed = dur.playPercentage() * ref.msec();
+  }
+
+  // Position in the file for a time of the process, mapped like in
+  // LayerPresenter::updateTempo: stretched files follow their native tempo,
+  // the others play at their speed whatever the tempo of the score.
+  double tempo = proc.stretchMode() == ossia::audio_stretch_mode::None
+                     ? Media::tempoAtStartDate(proc)
+                     : proc.nativeTempo();
+  if(tempo < 0.1)
+    tempo = ossia::root_tempo;
+  const double ratio = ossia::root_tempo / tempo;
+
+  const auto frames = [rate = m_prefetch->rate, ratio](double msec) {
+    return int64_t(msec * ratio * rate / 1000.);
+  };
+
+  double pos = proc.startOffset().msec() + elapsed;
+  int64_t loopEnd = -1;
+  if(proc.loops() && proc.loopDuration() > TimeVal::zero())
+  {
+    const double loop = proc.loopDuration().msec();
+    pos = std::fmod(pos, loop);
+    loopEnd = frames(loop);
+  }
+
+  Media::AudioPrefetcher::instance().seek(*m_prefetch, frames(pos), 0, loopEnd);
+}
+
+SoundComponent::~SoundComponent()
+{
+  if(m_prefetch)
+    Media::AudioPrefetcher::instance().remove(m_prefetch);
+}
 }
@@ -3,6 +3,8 @@
 #include <Process/Execution/ProcessComponent.hpp>
 #include <Process/Process.hpp>
 
+#include <Media/AudioPrefetcher.hpp>
+#include <Media/MediaFileHandle.hpp>
 #include <Media/Sound/SoundModel.hpp>
 
 #include <score/model/Component.hpp>
@@ -34,6 +36,11 @@ public:
 
 private:
   friend class Media::SoundComponentSetup;
+  void setPrefetch(const Media::AudioFile::MmapReader* reader);
+  void seekPrefetch();
+
+  std::shared_ptr<Media::AudioPrefetcher::Clip> m_prefetch;
+
   struct Recomputer : public Nano::Observer
   {
     explicit Recomputer(SoundComponent& self)
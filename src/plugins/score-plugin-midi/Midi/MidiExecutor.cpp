@@ -4,29 +4,26 @@
 
 #include <Midi/MidiProcess.hpp>
 
-#include <ossia/dataflow/nodes/midi.hpp>
+#include <QMetaObject>
 namespace Midi
 {
 namespace Executor
 {
 
 using midi_node = ossia::nodes::midi;
-static midi_node::note_set to_ossia(Component& c)
+
+// Past this many changes, rebuilding the note set is cheaper than
+// updating the sorted set note by note
+static constexpr std::size_t max_incremental_changes = 32;
+
+static NoteData clampToStart(NoteData data)
 {
-  midi_node::note_set notes;
-  auto& element = c.process();
-  notes.reserve(element.notes.size());
-  for(const auto& n : element.notes)
+  if(data.start() < 0 && data.end() > 0)
   {
-    auto data = n.noteData();
-    if(data.start() < 0 && data.end() > 0)
-    {
-      data.setStart(0.);
-      data.setDuration(data.duration() + data.start());
-    }
-    notes.insert(c.to_note(data));
+    data.setStart(0.);
+    data.setDuration(data.duration() + data.start());
   }
-  return notes;
+  return data;
 }
 
 using midi_node_process = ossia::nodes::midi_node_process;
@@ -40,54 +37,141 @@ Component::Component(
   m_ossia_process = std::make_shared<midi_node_process>(midi);
 
   midi->set_channel(element.channel());
-  midi->set_notes(to_ossia(*this));
-
-  element.notes.added.connect<&Component::on_noteAdded>(this);
-  element.notes.removing.connect<&Component::on_noteRemoved>(this);
-  element.notes.replaced.connect<&Component::on_notesReplaced>(this);
 
+  midi_node::note_set notes;
+  notes.reserve(element.notes.size());
+  m_notes.reserve(element.notes.size());
   for(auto& note : element.notes)
   {
-    QObject::connect(
-        &note, &Note::noteChanged, this,
-        [&, midi, cur = to_note(note.noteData())]() mutable {
-      auto old = cur;
-      cur = to_note(note.noteData());
-      in_exec([old, cur, midi] { midi->update_note(old, cur); });
-        });
+    auto nd = to_note(clampToStart(note.noteData()));
+    m_notes[&note] = nd;
+    notes.insert(nd);
+    connectNote(note);
   }
+  midi->set_notes(std::move(notes));
+
+  element.notes.added.connect<&Component::on_noteAdded>(this);
+  element.notes.removing.connect<&Component::on_noteRemoved>(this);
+  element.notes.replaced.connect<&Component::on_notesReplaced>(this);
 
-  QObject::connect(
-      &element, &Midi::ProcessModel::notesChanged, this, &Component::on_notesReplaced);
+  QObject::connect(&element, &Midi::ProcessModel::notesChanged, this, [this] {
+    m_replace = true;
+    scheduleUpdate();
+  });
 }
 
 Component::~Component() { }
 
+void Component::connectNote(const Note& n)
+{
+  QObject::connect(&n, &Note::noteChanged, this, [this, &n] {
+    m_dirty.insert(&n);
+    scheduleUpdate();
+  });
+}
+
 void Component::on_noteAdded(const Note& n)
 {
-  auto midi = std::dynamic_pointer_cast<midi_node>(node);
-  in_exec([nd = to_note(n.noteData()), midi] { midi->add_note(nd); });
-
-  QObject::connect(
-      &n, &Note::noteChanged, this, [&, midi, cur = to_note(n.noteData())]() mutable {
-        auto old = cur;
-        cur = to_note(n.noteData());
-        in_exec([old, cur, midi] { midi->update_note(old, cur); });
-      });
+  connectNote(n);
+  m_dirty.insert(&n);
+  scheduleUpdate();
 }
 
 void Component::on_noteRemoved(const Note& n)
 {
-  auto midi = std::dynamic_pointer_cast<midi_node>(node);
-  in_exec([nd = to_note(n.noteData()), midi] { midi->remove_note(nd); });
+  m_dirty.erase(&n);
+  if(auto it = m_notes.find(&n); it != m_notes.end())
+  {
+    m_removed.push_back(it->second);
+    m_notes.erase(it);
+  }
+  scheduleUpdate();
 }
 
 void Component::on_notesReplaced()
 {
+  // The previous notes have been deleted at this point
+  m_dirty.clear();
+  m_removed.clear();
+  m_notes.clear();
+  for(auto& note : process().notes)
+    connectNote(note);
+
+  m_replace = true;
+  scheduleUpdate();
+}
+
+void Component::scheduleUpdate()
+{
+  // Commands touching many notes emit one change per note and property:
+  // they are all sent to the execution thread at once.
+  if(m_scheduled)
+    return;
+  m_scheduled = true;
+  QMetaObject::invokeMethod(this, [this] { sendUpdates(); }, Qt::QueuedConnection);
+}
+
+void Component::sendUpdates()
+{
+  m_scheduled = false;
   auto midi = std::dynamic_pointer_cast<midi_node>(node);
+  if(!midi)
+    return;
 
-  in_exec([n = to_ossia(*this), midi]() mutable { midi->replace_notes(std::move(n)); });
+  auto& element = process();
+  if(m_replace || m_dirty.size() + m_removed.size() > max_incremental_changes)
+  {
+    m_notes.clear();
+    m_notes.reserve(element.notes.size());
+
+    midi_node::note_set notes;
+    notes.reserve(element.notes.size());
+    for(auto& note : element.notes)
+    {
+      auto nd = to_note(clampToStart(note.noteData()));
+      m_notes[&note] = nd;
+      notes.insert(nd);
+    }
+
+    in_exec([n = std::move(notes), midi]() mutable {
+      midi->replace_notes(std::move(n));
+    });
+  }
+  else if(!m_dirty.empty() || !m_removed.empty())
+  {
+    std::vector<ossia::nodes::note_data> added;
+    std::vector<std::pair<ossia::nodes::note_data, ossia::nodes::note_data>> updated;
+    for(const Note* note : m_dirty)
+    {
+      auto nd = to_note(clampToStart(note->noteData()));
+      auto [it, inserted] = m_notes.try_emplace(note, nd);
+      if(inserted)
+      {
+        added.push_back(nd);
+      }
+      else
+      {
+        updated.emplace_back(it->second, nd);
+        it->second = nd;
+      }
+    }
+
+    in_exec([removed = std::move(m_removed), updated = std::move(updated),
+             added = std::move(added), midi] {
+      for(auto& nd : removed)
+        midi->remove_note(nd);
+      for(auto& [old, cur] : updated)
+        midi->update_note(old, cur);
+      for(auto& nd : added)
+        midi->add_note(nd);
+    });
+  }
+
+  m_dirty.clear();
+  m_removed.clear();
+  m_replace = false;
 }
+
 ossia::nodes::note_data Component::to_note(const NoteData& n)
 {
   auto& cv_time = system().time;
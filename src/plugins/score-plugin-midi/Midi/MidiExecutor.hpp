@@ -5,13 +5,10 @@
 #include <Midi/MidiNote.hpp>
 
 #include <ossia/dataflow/node_process.hpp>
+#include <ossia/dataflow/nodes/midi.hpp>
 #include <ossia/detail/flat_set.hpp>
+#include <ossia/detail/hash_map.hpp>
 #include <ossia/editor/scenario/time_process.hpp>
-namespace ossia::nodes
-{
-struct note_data;
-}
-
 namespace Device
 {
 class DeviceList;
@@ -36,6 +33,20 @@ public:
   void on_notesReplaced();
 
   ossia::nodes::note_data to_note(const NoteData& n);
+
+private:
+  void connectNote(const Midi::Note&);
+  void scheduleUpdate();
+  void sendUpdates();
+
+  // The notes as they currently are in the execution node
+  ossia::hash_map<const Note*, ossia::nodes::note_data> m_notes;
+
+  // Changes accumulated since the last update sent to the execution thread
+  ossia::hash_set<const Note*> m_dirty;
+  std::vector<ossia::nodes::note_data> m_removed;
+  bool m_replace{};
+  bool m_scheduled{};
 };
 
 using ComponentFactory = ::Execution::ProcessComponentFactory_T<Component>;
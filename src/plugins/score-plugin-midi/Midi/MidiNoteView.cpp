@@ -5,7 +5,6 @@
 #include <Process/Focus/FocusDispatcher.hpp>
 
 #include <Midi/MidiPresenter.hpp>
-#include <Midi/MidiStyle.hpp>
 #include <Midi/MidiView.hpp>
 
 #include <score/document/DocumentContext.hpp>
@@ -13,7 +12,6 @@
 #include <QCursor>
 #include <QGraphicsSceneMouseEvent>
 #include <QGuiApplication>
-#include <QPainter>
 namespace Midi
 {
 
@@ -27,27 +25,27 @@ NoteView::NoteView(const Note& n, Presenter& p, View* parent)
   this->setFlag(QGraphicsItem::ItemIsSelectable, true);
   this->setFlag(QGraphicsItem::ItemIsMovable, true);
   this->setFlag(QGraphicsItem::ItemSendsGeometryChanges, true);
+  this->setFlag(QGraphicsItem::ItemHasNoContents, true);
   this->setAcceptHoverEvents(true);
 }
 
-void NoteView::paint(
-    QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
+void NoteView::setWidth(qreal w) noexcept
 {
-  static const MidiStyle s;
-
-  painter->setRenderHint(QPainter::Antialiasing, false);
-
-  if(m_width <= 1.2)
+  if(m_width != w)
   {
-    painter->setPen(this->isSelected() ? s.noteSelectedBasePen : s.noteBasePen);
-    painter->drawLine(0, 0, 0, m_height - 1.5);
+    prepareGeometryChange();
+    m_width = w;
+    static_cast<View*>(parentItem())->invalidateNotes();
   }
-  else
-  {
-    painter->setPen(this->isSelected() ? s.noteSelectedBasePen : Qt::NoPen);
-    painter->setBrush(s.paintedNoteBrush[note.velocity()]);
+}
 
-    painter->drawRect(boundingRect().adjusted(0., 0., 0., 0));
+void NoteView::setHeight(qreal h) noexcept
+{
+  if(m_height != h)
+  {
+    prepareGeometryChange();
+    m_height = h;
+    static_cast<View*>(parentItem())->invalidateNotes();
   }
 }
 
@@ -95,6 +93,10 @@ NoteView::itemChange(QGraphicsItem::GraphicsItemChange change, const QVariant& v
       this->setZValue(10 * (int)b);
       break;
     }
+    case QGraphicsItem::ItemPositionHasChanged:
+    case QGraphicsItem::ItemSelectedHasChanged:
+      static_cast<View*>(parentItem())->invalidateNotes();
+      break;
     default:
       break;
   }
@@ -15,27 +15,13 @@ public:
 
   NoteView(const Note& n, Presenter& presenter, View* parent);
 
-  void setWidth(qreal w) noexcept
-  {
-    if(m_width != w)
-    {
-      prepareGeometryChange();
-      m_width = w;
-    }
-  }
-
-  void setHeight(qreal h) noexcept
-  {
-    if(m_height != h)
-    {
-      prepareGeometryChange();
-      m_height = h;
-    }
-  }
+  void setWidth(qreal w) noexcept;
+  void setHeight(qreal h) noexcept;
 
   QRectF boundingRect() const override { return {0, 0, m_width, m_height}; }
-  void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
-      override;
+
+  //! The notes are drawn all at once by the parent View
+  void paint(QPainter*, const QStyleOptionGraphicsItem*, QWidget*) override { }
 
   QRectF computeRect() const noexcept;
   QPointF closestPos(QPointF note) const noexcept;
@@ -25,10 +25,6 @@
 #include <ossia/detail/algorithms.hpp>
 #include <ossia/detail/math.hpp>
 
-#include <boost/range/adaptor/filtered.hpp>
-#include <boost/range/adaptor/transformed.hpp>
-#include <boost/range/algorithm/copy.hpp>
-
 #include <QAction>
 #include <QApplication>
 #include <QInputDialog>
@@ -53,36 +49,16 @@ Presenter::Presenter(
   auto& model = layer;
 
   con(
-      model, &ProcessModel::durationChanged, this,
-      [&] {
-    for(auto note : m_notes)
-      updateNote(*note);
-      },
+      model, &ProcessModel::durationChanged, this, [&] { updateNotes(); },
       Qt::QueuedConnection);
-  con(model, &ProcessModel::notesNeedUpdate, this, [&] {
-    for(auto note : m_notes)
-      updateNote(*note);
-  });
+  con(model, &ProcessModel::notesNeedUpdate, this, [&] { updateNotes(); });
 
-  con(model, &ProcessModel::notesChanged, this, [&] {
-    for(auto note : m_notes)
-    {
-      delete note;
-    }
-
-    m_notes.clear();
-    m_selectedNotes.clear();
-
-    for(auto& note : model.notes)
-    {
-      on_noteAdded(note);
-    }
-  });
+  // The notes are still the same, only their position changed
+  con(model, &ProcessModel::notesChanged, this, [&] { updateNotes(); });
 
   con(model, &ProcessModel::rangeChanged, this, [this](int min, int max) {
     m_view->setRange(min, max);
-    for(auto note : m_notes)
-      updateNote(*note);
+    updateNotes();
   });
   m_view->setRange(model.range().first, model.range().second);
   model.notes.added.connect<&Presenter::on_noteAdded>(this);
@@ -94,10 +70,7 @@ Presenter::Presenter(
         new AddNote{layer, m_view->noteAtPos(pos)});
   });
 
-  connect(m_view, &View::pressed, this, [&] {
-    for(NoteView* n : m_notes)
-      n->setSelected(false);
-  });
+  connect(m_view, &View::pressed, this, [&] { on_deselectOtherNotes(); });
 
   connect(m_view, &View::dropReceived, this, &Presenter::on_drop);
 
@@ -106,6 +79,7 @@ Presenter::Presenter(
         new RemoveNotes{this->model(), selectedNotes()});
   });
 
+  m_notes.reserve(model.notes.size());
   for(auto& note : model.notes)
   {
     on_noteAdded(note);
@@ -155,15 +129,13 @@ void Presenter::setWidth(qreal val, qreal defaultWidth)
 {
   m_view->setWidth(val);
   m_view->setDefaultWidth(defaultWidth);
-  for(auto note : m_notes)
-    updateNote(*note);
+  updateNotes();
 }
 
 void Presenter::setHeight(qreal val)
 {
   m_view->setHeight(val);
-  for(auto note : m_notes)
-    updateNote(*note);
+  updateNotes();
 }
 
 void Presenter::putToFront()
@@ -180,8 +152,7 @@ void Presenter::on_zoomRatioChanged(ZoomRatio zr)
 {
   m_zr = zr;
   m_view->setDefaultWidth(model().duration().toPixels(m_zr));
-  for(auto note : m_notes)
-    updateNote(*note);
+  updateNotes();
 }
 
 void Presenter::parentGeometryChanged() { }
@@ -198,7 +169,9 @@ const Midi::View& Presenter::view() const noexcept
 
 void Presenter::on_deselectOtherNotes()
 {
-  for(NoteView* n : m_notes)
+  // Copied as deselecting modifies the set
+  const std::vector<NoteView*> selected(m_selectedNotes.begin(), m_selectedNotes.end());
+  for(NoteView* n : selected)
     n->setSelected(false);
 }
 
@@ -267,6 +240,7 @@ void Presenter::on_requestVelocityChange(const Note& note, double velocityDelta)
   }
 
   m_velocityDispatcher.submit(model(), notes, velocityDelta / 5.);
+  m_view->update();
 }
 
 void Presenter::on_duplicate() { }
@@ -279,9 +253,22 @@ void Presenter::on_velocityChangeFinished()
 void Presenter::on_noteSelectionChanged(NoteView* v, bool ok)
 {
   if(ok)
-    m_selectedNotes.push_back(v);
+    m_selectedNotes.insert(v);
   else
-    ossia::remove_erase(m_selectedNotes, v);
+    m_selectedNotes.erase(v);
+
+  // A rubber band selection changes the selection of many notes at once:
+  // only the final selection is pushed.
+  if(!m_selectionPending)
+  {
+    m_selectionPending = true;
+    QMetaObject::invokeMethod(this, [this] { pushSelection(); }, Qt::QueuedConnection);
+  }
+}
+
+void Presenter::pushSelection()
+{
+  m_selectionPending = false;
 
   Selection s;
   for(auto n : m_selectedNotes)
@@ -303,43 +290,40 @@ void Presenter::updateNote(NoteView& v)
   v.setHeight(noteRect.height());
 }
 
+void Presenter::updateNotes()
+{
+  for(auto& [note, view] : m_notes)
+    updateNote(*view);
+  m_view->invalidateNotes();
+}
+
 void Presenter::on_noteAdded(const Note& n)
 {
   auto v = new NoteView{n, *this, m_view};
   updateNote(*v);
-  m_notes.push_back(v);
+  m_notes[&n] = v;
+  m_view->invalidateNotes();
 }
 
 void Presenter::on_noteRemoving(const Note& n)
 {
+  if(auto it = m_notes.find(&n); it != m_notes.end())
   {
-    auto it = ossia::find_if(
-        m_selectedNotes, [&](const auto& other) { return &other->note == &n; });
-
-    if(it != m_selectedNotes.end())
-    {
-      m_selectedNotes.erase(it);
-    }
-  }
-  {
-    auto it
-        = ossia::find_if(m_notes, [&](const auto& other) { return &other->note == &n; });
-
-    if(it != m_notes.end())
-    {
-      delete *it;
-      m_notes.erase(it);
-    }
+    m_selectedNotes.erase(it->second);
+    delete it->second;
+    m_notes.erase(it);
+    m_view->invalidateNotes();
   }
 }
 
 void Presenter::on_notesReplaced()
 {
   m_selectedNotes.clear();
-  for(auto& n : m_notes)
-    delete n;
+  for(auto& [note, view] : m_notes)
+    delete view;
   m_notes.clear();
 
+  m_notes.reserve(this->model().notes.size());
   for(auto& note : this->model().notes)
   {
     on_noteAdded(note);
@@ -372,13 +356,10 @@ void Presenter::on_drop(const QPointF& pos, const QMimeData& md)
 
 std::vector<Id<Note>> Presenter::selectedNotes() const
 {
-  using namespace boost::adaptors;
-
   std::vector<Id<Note>> res;
-  boost::copy(
-      m_notes | filtered([](NoteView* v) { return v->isSelected(); })
-          | transformed([](NoteView* v) { return v->note.id(); }),
-      std::back_inserter(res));
+  res.reserve(m_selectedNotes.size());
+  for(NoteView* v : m_selectedNotes)
+    res.push_back(v->note.id());
   return res;
 }
 }
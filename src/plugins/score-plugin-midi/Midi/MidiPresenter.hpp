@@ -6,6 +6,8 @@
 
 #include <score/command/Dispatchers/SingleOngoingCommandDispatcher.hpp>
 
+#include <ossia/detail/hash_map.hpp>
+
 #include <nano_observer.hpp>
 class QMimeData;
 namespace Midi
@@ -48,6 +50,8 @@ public:
 
 private:
   void updateNote(NoteView&);
+  void updateNotes();
+  void pushSelection();
   void on_noteAdded(const Note&);
   void on_noteRemoving(const Note&);
   void on_notesReplaced();
@@ -56,8 +60,9 @@ private:
   std::vector<Id<Note>> selectedNotes() const;
 
   View* m_view{};
-  std::vector<NoteView*> m_notes;
-  std::vector<NoteView*> m_selectedNotes;
+  ossia::hash_map<const Note*, NoteView*> m_notes;
+  ossia::hash_set<NoteView*> m_selectedNotes;
+  bool m_selectionPending{};
 
   SingleOngoingCommandDispatcher<MoveNotes> m_moveDispatcher;
   SingleOngoingCommandDispatcher<ChangeNotesVelocity> m_velocityDispatcher;
@@ -2,6 +2,7 @@
 // it. PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
 #include "MidiView.hpp"
 
+#include <Midi/MidiNoteView.hpp>
 #include <Midi/MidiStyle.hpp>
 
 #include <score/graphics/GraphicsItem.hpp>
@@ -153,10 +154,7 @@ void View::widthChanged(qreal w) { }
 void View::setDefaultWidth(double w)
 {
   m_defaultW = w;
-  update();
-  const auto& children = childItems();
-  for(auto cld : children)
-    cld->update();
+  invalidateNotes();
 }
 
 void View::setRange(int min, int max)
@@ -175,10 +173,111 @@ bool View::canEdit() const
   return note_height > 5;
 }
 
+void View::invalidateNotes()
+{
+  m_sortedNotes.dirty = true;
+  update();
+}
+
+void View::paintNotes(QPainter* p, double left, double right) const
+{
+  auto& notes = m_sortedNotes;
+  if(notes.dirty)
+  {
+    const auto children = childItems();
+    notes.items.clear();
+    notes.items.reserve(children.size());
+    for(auto item : children)
+      notes.items.push_back(static_cast<const NoteView*>(item));
+    std::sort(notes.items.begin(), notes.items.end(), [](auto lhs, auto rhs) {
+      return lhs->x() < rhs->x();
+    });
+
+    notes.x.resize(notes.items.size());
+    notes.maxWidth = 0.;
+    for(std::size_t i = 0; i < notes.items.size(); i++)
+    {
+      notes.x[i] = notes.items[i]->x();
+      notes.maxWidth
+          = std::max(notes.maxWidth, notes.items[i]->boundingRect().width());
+    }
+    notes.dirty = false;
+  }
+
+  // Notes starting before the visible area may still overlap it
+  const auto first = std::lower_bound(
+                         notes.x.begin(), notes.x.end(), left - notes.maxWidth - 1.)
+                     - notes.x.begin();
+  const auto last = std::upper_bound(notes.x.begin() + first, notes.x.end(), right)
+                    - notes.x.begin();
+
+  // Group the notes by velocity to draw them in as few calls as possible
+  for(auto& rects : m_noteRects)
+    rects.clear();
+  m_noteLines.clear();
+  m_selectedNotes.clear();
+  for(auto i = first; i < last; i++)
+  {
+    auto note = notes.items[i];
+    const auto rect = note->boundingRect().translated(note->pos());
+    if(rect.right() < left)
+      continue;
+
+    if(note->isSelected())
+      m_selectedNotes.push_back(note);
+    else if(rect.width() <= 1.2)
+      m_noteLines.emplace_back(
+          rect.left(), rect.top(), rect.left(), rect.bottom() - 1.5);
+    else
+      m_noteRects[std::clamp(int(note->note.velocity()), 0, 127)].push_back(rect);
+  }
+
+  p->setRenderHint(QPainter::Antialiasing, false);
+  p->setPen(Qt::NoPen);
+  for(std::size_t v = 0; v < std::size(m_noteRects); v++)
+  {
+    if(!m_noteRects[v].empty())
+    {
+      p->setBrush(style.paintedNoteBrush[v]);
+      p->drawRects(m_noteRects[v].data(), m_noteRects[v].size());
+    }
+  }
+
+  if(!m_noteLines.empty())
+  {
+    p->setPen(style.noteBasePen);
+    p->drawLines(m_noteLines.data(), m_noteLines.size());
+  }
+
+  // Selected notes are drawn on top of the others
+  p->setPen(style.noteSelectedBasePen);
+  for(auto note : m_selectedNotes)
+  {
+    const auto rect = note->boundingRect().translated(note->pos());
+    if(rect.width() <= 1.2)
+    {
+      p->drawLine(QLineF{rect.left(), rect.top(), rect.left(), rect.bottom() - 1.5});
+    }
+    else
+    {
+      const int velocity = std::clamp(int(note->note.velocity()), 0, 127);
+      p->setBrush(style.paintedNoteBrush[velocity]);
+      p->drawRect(rect);
+    }
+  }
+}
+
 void View::paint_impl(QPainter* p) const
 {
+  double notes_left = 0.;
+  double notes_right = width();
   if(auto v = getView(*this))
   {
+    const auto visible
+        = mapFromScene(v->mapToScene(v->viewport()->rect())).boundingRect();
+    notes_left = std::max(notes_left, visible.left());
+    notes_right = std::min(notes_right, visible.right());
+
     if(canEdit())
     {
       const double dpi = p->device()->devicePixelRatioF();
@@ -220,6 +319,9 @@ void View::paint_impl(QPainter* p) const
       }
     }
   }
+
+  paintNotes(p, notes_left, notes_right);
+
   if(!m_selectArea.isEmpty())
   {
     p->setBrush(style.transparentBrush);
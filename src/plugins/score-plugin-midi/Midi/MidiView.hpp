@@ -26,6 +26,9 @@ public:
   NoteData noteAtPos(QPointF point) const;
   int visibleCount() const;
 
+  //! To be called when notes are added, removed, moved or selected
+  void invalidateNotes();
+
 public:
   void deleteRequested() W_SIGNAL(deleteRequested);
 
@@ -42,6 +45,7 @@ private:
   void dropEvent(QGraphicsSceneDragDropEvent* event) override;
 
   void updateBackground(double height);
+  void paintNotes(QPainter* p, double left, double right) const;
 
   QPainterPath m_selectArea;
   double m_defaultW; // Covers the [ 0; 1 ] area
@@ -51,5 +55,20 @@ private:
   QPixmap m_bgCache;
 
   mutable std::vector<QPainter::PixmapFragment> m_fragmentCache;
+
+  // The note items sorted by position, to only paint the visible ones
+  struct SortedNotes
+  {
+    std::vector<double> x;
+    std::vector<const NoteView*> items;
+    double maxWidth{};
+    bool dirty{true};
+  };
+  mutable SortedNotes m_sortedNotes;
+
+  // Reused across paints
+  mutable std::vector<QRectF> m_noteRects[128];
+  mutable std::vector<const NoteView*> m_selectedNotes;
+  mutable std::vector<QLineF> m_noteLines;
 };
 }
@@ -21,6 +21,8 @@
 
 #include <QFileInfo>
 
+#include <algorithm>
+#include <array>
 #include <vector>
 namespace Pd
 {
@@ -30,45 +32,44 @@ thread_local PdGraphNode* m_currentInstance{};
 struct ossia_to_pd_value
 {
   const char* mess{};
+  std::vector<t_atom>& atoms;
   void operator()() const { }
 
   void just_add_values(const ossia::value& value) const noexcept
   {
+    auto add_float = [this](float f) { libpd_set_float(&atoms.emplace_back(), f); };
     switch(value.get_type())
     {
       case ossia::val_type::INT:
-        libpd_add_float(value.get<int>());
+        add_float(value.get<int>());
         break;
       case ossia::val_type::FLOAT:
-        libpd_add_float(value.get<float>());
+        add_float(value.get<float>());
         break;
       case ossia::val_type::BOOL:
-        libpd_add_float(value.get<bool>());
+        add_float(value.get<bool>());
         break;
       case ossia::val_type::STRING:
-        libpd_add_symbol(value.get<std::string>().c_str());
+        libpd_set_symbol(&atoms.emplace_back(), value.get<std::string>().c_str());
         break;
       case ossia::val_type::VEC2F:
-        libpd_add_float(value.get<ossia::vec2f>()[0]);
-        libpd_add_float(value.get<ossia::vec2f>()[1]);
+        for(float f : value.get<ossia::vec2f>())
+          add_float(f);
         break;
       case ossia::val_type::VEC3F:
-        libpd_add_float(value.get<ossia::vec3f>()[0]);
-        libpd_add_float(value.get<ossia::vec3f>()[1]);
-        libpd_add_float(value.get<ossia::vec3f>()[3]);
+        for(float f : value.get<ossia::vec3f>())
+          add_float(f);
         break;
       case ossia::val_type::VEC4F:
-        libpd_add_float(value.get<ossia::vec4f>()[0]);
-        libpd_add_float(value.get<ossia::vec4f>()[1]);
-        libpd_add_float(value.get<ossia::vec4f>()[2]);
-        libpd_add_float(value.get<ossia::vec4f>()[3]);
+        for(float f : value.get<ossia::vec4f>())
+          add_float(f);
         break;
       case ossia::val_type::LIST:
         for(auto& v : value.get<std::vector<ossia::value>>())
           just_add_values(v);
         break;
       case ossia::val_type::IMPULSE:
-        libpd_add_float(1.f);
+        add_float(1.f);
         break;
 
       case ossia::val_type::MAP:
@@ -76,42 +77,27 @@ struct ossia_to_pd_value
         break;
     }
   }
+
+  // The whole list is built in the preallocated atoms, and sent at once
   void operator()(const std::vector<ossia::value>& v) const
   {
-    // TODO improve that
-    libpd_start_message(v.size());
+    atoms.clear();
     for(auto& value : v)
     {
       just_add_values(value);
     }
-    libpd_finish_list(mess);
+    libpd_list(mess, atoms.size(), atoms.data());
   }
 
   void operator()(const ossia::value_map_type& v) const { }
 
-  void operator()(const ossia::vec2f& v) const
-  {
-    libpd_start_message(2);
-    libpd_add_float(v[0]);
-    libpd_add_float(v[1]);
-    libpd_finish_list(mess);
-  }
-  void operator()(const ossia::vec3f& v) const
+  template <std::size_t N>
+  void operator()(const std::array<float, N>& v) const
   {
-    libpd_start_message(3);
-    libpd_add_float(v[0]);
-    libpd_add_float(v[1]);
-    libpd_add_float(v[2]);
-    libpd_finish_list(mess);
-  }
-  void operator()(const ossia::vec4f& v) const
-  {
-    libpd_start_message(4);
-    libpd_add_float(v[0]);
-    libpd_add_float(v[1]);
-    libpd_add_float(v[2]);
-    libpd_add_float(v[3]);
-    libpd_finish_list(mess);
+    t_atom list[N];
+    for(std::size_t i = 0; i < N; i++)
+      libpd_set_float(&list[i], v[i]);
+    libpd_list(mess, N, list);
   }
 
   void operator()(float f) const { libpd_float(mess, f); }
@@ -178,9 +164,8 @@ PdGraphNode::PdGraphNode(
   const std::size_t bs = libpd_blocksize();
   m_inbuf.resize(m_audioIns * bs);
   m_outbuf.resize(m_audioOuts * bs);
-  m_prev_outbuf.resize(m_audioOuts);
-  for(auto& circ : m_prev_outbuf)
-    circ.set_capacity(8192);
+  m_prev_outbuf.reset(m_audioOuts, 8192);
+  m_atoms.reserve(64);
 
   // Create instance
   libpd_set_instance(m_instance->instance);
@@ -329,6 +314,55 @@ PdGraphNode::PdGraphNode(
 
 PdGraphNode::~PdGraphNode() { }
 
+void BlockFifo::reset(std::size_t channels, std::size_t capacity)
+{
+  m_channels = channels;
+  m_capacity = capacity;
+  m_data.assign(channels * capacity, 0.f);
+  m_begin = 0;
+  m_end = 0;
+}
+
+void BlockFifo::push(const float* block, std::size_t n)
+{
+  if(m_end + n > m_capacity)
+  {
+    // Move what is left to the beginning of each channel,
+    // growing only if more than the capacity gets requested in a single tick
+    const std::size_t count = size();
+    const std::size_t capacity = std::max(m_capacity, 2 * (count + n));
+    if(capacity != m_capacity)
+    {
+      std::vector<float> data(m_channels * capacity);
+      for(std::size_t i = 0; i < m_channels; i++)
+        std::copy_n(channel(i), count, data.data() + i * capacity);
+      m_data = std::move(data);
+      m_capacity = capacity;
+    }
+    else
+    {
+      for(std::size_t i = 0; i < m_channels; i++)
+        std::copy(channel(i), channel(i) + count, m_data.data() + i * m_capacity);
+    }
+    m_begin = 0;
+    m_end = count;
+  }
+
+  for(std::size_t i = 0; i < m_channels; i++)
+    std::copy_n(block + i * n, n, m_data.data() + i * m_capacity + m_end);
+  m_end += n;
+}
+
+void BlockFifo::consume(std::size_t n) noexcept
+{
+  m_begin = std::min(m_begin + n, m_end);
+  if(m_begin == m_end)
+  {
+    m_begin = 0;
+    m_end = 0;
+  }
+}
+
 ossia::outlet* PdGraphNode::get_outlet(const char* str) const
 {
   ossia::string_view s = str;
@@ -413,7 +447,7 @@ void PdGraphNode::run(const ossia::token_request& t, ossia::exec_state_facade e)
 
     for(auto& val : dat)
     {
-      val.value.apply(ossia_to_pd_value{mess});
+      val.value.apply(ossia_to_pd_value{mess, m_atoms});
     }
   }
 
@@ -425,62 +459,31 @@ void PdGraphNode::run(const ossia::token_request& t, ossia::exec_state_facade e)
   {
     libpd_process_raw(m_inbuf.data(), m_outbuf.data());
   }
-  else if(int64_t prev_out_size = m_prev_outbuf[0].size(); req_samples > prev_out_size)
+  else if(int64_t prev_out_size = m_prev_outbuf.size(); req_samples > prev_out_size)
   {
-    int64_t additional_samples = std::max(int64_t(bs), req_samples - prev_out_size);
-    while(additional_samples > 0)
+    // All the blocks needed for this tick are computed in a row
+    const int64_t blocks = (req_samples - prev_out_size + bs - 1) / bs;
+    for(int64_t b = 0; b < blocks; b++)
     {
-      std::size_t offset = m_prev_outbuf[0].size();
       // Copy audio inputs
-      if(m_audioIns > 0)
+      const int64_t offset = prev_out_size + b * bs;
+      for(std::size_t i = 0U; i < input_channels; i++)
       {
-        for(std::size_t i = 0U; i < input_channels; i++)
-        {
-          auto& channel = m_audio_inlet->channel(i);
-          int64_t available_input_samples = channel.size();
-          available_input_samples -= offset;
-
-          if(available_input_samples > 0)
-          {
-            int64_t samples_to_copy = std::min(int64_t(bs), additional_samples);
-            if(samples_to_copy < available_input_samples)
-            {
-              SCORE_ASSERT(offset + samples_to_copy <= channel.size());
-              SCORE_ASSERT(i * bs + samples_to_copy <= m_inbuf.size());
-              std::copy_n(
-                  channel.begin() + offset, samples_to_copy, m_inbuf.begin() + i * bs);
-            }
-            else
-            {
-              SCORE_ASSERT(offset + available_input_samples <= channel.size());
-              SCORE_ASSERT(i * bs + available_input_samples <= m_inbuf.size());
-              std::copy_n(
-                  channel.begin() + offset, available_input_samples,
-                  m_inbuf.begin() + i * bs);
-              std::fill_n(
-                  m_inbuf.begin() + i * bs + available_input_samples,
-                  bs - available_input_samples, 0.f);
-            }
-          }
-          else
-          {
-            std::fill_n(m_inbuf.begin() + i * bs, bs, 0.f);
-          }
-        }
+        auto& channel = m_audio_inlet->channel(i);
+        const int64_t available
+            = std::clamp(int64_t(channel.size()) - offset, int64_t(0), int64_t(bs));
+
+        auto in = m_inbuf.begin() + i * bs;
+        if(available > 0)
+          std::copy_n(channel.begin() + offset, available, in);
+        std::fill_n(in + available, bs - available, 0.f);
       }
 
       // Process
       libpd_process_raw(m_inbuf.data(), m_outbuf.data());
 
       // Put the outputs back in the ring buffer
-      for(std::size_t i = 0; i < m_audioOuts; ++i)
-      {
-        for(std::size_t j = 0; j < bs; j++)
-        {
-          m_prev_outbuf[i].push_back(m_outbuf[i * bs + j]);
-        }
-      }
-      additional_samples -= bs;
+      m_prev_outbuf.push(m_outbuf.data(), bs);
     }
   }
 
@@ -500,16 +503,16 @@ void PdGraphNode::run(const ossia::token_request& t, ossia::exec_state_facade e)
       for(std::size_t i = 0U; i < m_audioOuts; ++i)
       {
         auto& channel = m_audio_outlet->channel(i);
-        auto& circbuf = m_prev_outbuf[i];
         const auto silence_samples = std::max(
             uint64_t(channel.size()), uint64_t(t.physical_start(e.modelToSamples())));
         const auto total_samples = silence_samples + req_samples;
         channel.reserve(total_samples);
         channel.resize(silence_samples);
 
-        channel.insert(channel.end(), circbuf.begin(), circbuf.begin() + req_samples);
-        circbuf.erase_begin(req_samples);
+        const float* prev = m_prev_outbuf.channel(i);
+        channel.insert(channel.end(), prev, prev + req_samples);
       }
+      m_prev_outbuf.consume(req_samples);
     }
   }
 
@@ -574,8 +577,8 @@ Component::Component(
       auto& vp = *inl->target<ossia::value_port>();
       vp.type = inlet->value().get_type();
       vp.domain = inlet->domain().get();
-      inlet->value().apply(
-          ossia_to_pd_value{pdnode->m_inmess[i - pdnode->m_firstInMessage].c_str()});
+      inlet->value().apply(ossia_to_pd_value{
+          pdnode->m_inmess[i - pdnode->m_firstInMessage].c_str(), pdnode->m_atoms});
       auto c = connect(
           inlet, &Process::ControlInlet::valueChanged, this,
           [this, inl](const ossia::value& v) {
@@ -15,17 +15,47 @@
 #include <ossia/editor/scenario/time_process.hpp>
 #include <ossia/editor/scenario/time_value.hpp>
 
-#include <boost/circular_buffer.hpp>
-
 #include <QString>
 
 #include <memory>
+#include <vector>
 
+struct _atom;
 namespace Pd
 {
 
 class ProcessModel;
 
+/**
+ * @brief Audio computed by Pd ahead of what was requested.
+ *
+ * Pd computes 64 samples at a time: what is left over at the end of a tick
+ * is kept for the next one. Each channel is stored contiguously, so that
+ * blocks are appended and read back with a single copy per channel.
+ */
+class BlockFifo
+{
+public:
+  void reset(std::size_t channels, std::size_t capacity);
+
+  std::size_t size() const noexcept { return m_end - m_begin; }
+  const float* channel(std::size_t i) const noexcept
+  {
+    return m_data.data() + i * m_capacity + m_begin;
+  }
+
+  //! Appends one block of n samples per channel, stored one channel after the other
+  void push(const float* block, std::size_t n);
+  void consume(std::size_t n) noexcept;
+
+private:
+  std::vector<float> m_data;
+  std::size_t m_channels{};
+  std::size_t m_capacity{};
+  std::size_t m_begin{};
+  std::size_t m_end{};
+};
+
 class PdGraphNode final : public ossia::graph_node
 {
 public:
@@ -55,7 +85,10 @@ public:
   std::vector<std::string> m_inmess, m_outmess;
 
   std::vector<float> m_inbuf, m_outbuf;
-  std::vector<boost::circular_buffer<float>> m_prev_outbuf;
+  BlockFifo m_prev_outbuf;
+
+  // Lists are sent to Pd from here, to not allocate while the patch runs
+  std::vector<_atom> m_atoms;
   std::size_t m_firstInMessage{}, m_firstOutMessage{};
   ossia::audio_port* m_audio_inlet{};
   ossia::audio_port* m_audio_outlet{};
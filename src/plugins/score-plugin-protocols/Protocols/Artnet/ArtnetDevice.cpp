@@ -4,6 +4,7 @@
 #if defined(OSSIA_PROTOCOL_ARTNET)
 #include "ArtnetDevice.hpp"
 #include "ArtnetSpecificSettings.hpp"
+#include "DMXMultiUniverseProtocol.hpp"
 
 #include <Explorer/DocumentPlugin/DeviceDocumentPlugin.hpp>
 
@@ -40,10 +41,28 @@ ArtnetDevice::~ArtnetDevice() { }
 
 namespace
 {
+// buffers points to universe_count contiguous universes:
+// the fixture address is absolute in this block.
 static void addArtnetFixture(
-    ossia::net::generic_device& dev, ossia::net::dmx_buffer& buffer,
-    const Artnet::Fixture& fix)
+    ossia::net::generic_device& dev, ossia::net::dmx_buffer* buffers,
+    int universe_count, const Artnet::Fixture& fix)
 {
+  // The channels of a fixture, fine ones included, are written in the buffer
+  // of a single universe
+  const int channel_count = std::max(1, int(fix.mode.channelNames.size()));
+  if(fix.address / 512 != (fix.address + channel_count - 1) / 512)
+  {
+    qDebug() << "ArtNet error: fixture" << fix.fixtureName
+             << "crosses a universe boundary";
+    return;
+  }
+  if((fix.address + channel_count - 1) / 512 >= universe_count)
+  {
+    qDebug() << "ArtNet error: fixture" << fix.fixtureName
+             << "is outside of the universes of the device";
+    return;
+  }
+
   // For each fixture, we'll create a node.
   auto fixt_node = dev.create_child(fix.fixtureName.toStdString());
   if(!fixt_node)
@@ -57,7 +76,9 @@ static void addArtnetFixture(
         = ossia::index_in_container(fix.mode.channelNames, chan.name);
     if(channel_offset == -1)
       continue;
-    const int dmx_channel = fix.address + channel_offset;
+    const int block_channel = fix.address + channel_offset;
+    auto& buffer = buffers[block_channel / 512];
+    const int dmx_channel = block_channel % 512;
 
     // Then for each range-based subchannels, sub-nodes with the relevant domains.
     struct chan_visitor
@@ -86,7 +107,7 @@ static void addArtnetFixture(
             bytes++;
           }
         }
-        p.m_bytes = bytes;
+        p.m_bytes = std::min(bytes, 512 - dmx_channel);
 
         chan_node->set_parameter(std::move(chan_param));
         p.set_default_value(chan.defaultValue);
@@ -215,6 +236,48 @@ bool ArtnetDevice::reconnect()
                     ? ossia::net::dmx_config::source
                     : ossia::net::dmx_config::sink;
 
+    // Several universes from a single device: one socket and one sender timer
+    // for the whole block.
+    const bool multi_universe
+        = set.universeCount > 1 && set.mode == ArtnetSpecificSettings::Source
+          && (set.transport == ArtnetSpecificSettings::ArtNet
+              || set.transport == ArtnetSpecificSettings::ArtNetV2
+              || set.transport == ArtnetSpecificSettings::E131);
+    if(set.universeCount > 1 && !multi_universe)
+      qDebug() << "ArtNet: only universe" << set.universe
+               << "is used, several universes are only supported when sending "
+                  "Art-Net or sACN";
+
+    if(multi_universe)
+    {
+      dmx_multi_universe_protocol::configuration multi_conf;
+      multi_conf.transport = set.transport == ArtnetSpecificSettings::E131
+                                 ? dmx_multi_universe_protocol::e131
+                                 : dmx_multi_universe_protocol::artnet;
+      multi_conf.host = set.host.toStdString();
+      if(multi_conf.host == "0.0.0.0")
+        multi_conf.host.clear();
+      multi_conf.first_universe = set.universe;
+      multi_conf.universe_count = set.universeCount;
+      multi_conf.frequency = set.rate;
+      multi_conf.autocreate = set.fixtures.empty();
+
+      auto multi_proto
+          = std::make_unique<dmx_multi_universe_protocol>(m_ctx, multi_conf);
+      auto& proto = *multi_proto;
+      auto dev = std::make_unique<ossia::net::generic_device>(
+          std::move(multi_proto), settings().name.toStdString());
+
+      for(auto& fixt : set.fixtures)
+      {
+        addArtnetFixture(*dev, &proto.universe(0), proto.universe_count(), fixt);
+      }
+
+      m_dev = std::move(dev);
+      deviceChanged(nullptr, m_dev.get());
+      return connected();
+    }
+
     // Create the protocol
     std::unique_ptr<ossia::net::dmx_protocol_base> artnet_proto;
     switch(set.transport)
@@ -285,7 +348,7 @@ bool ArtnetDevice::reconnect()
 
       for(auto& fixt : set.fixtures)
       {
-        addArtnetFixture(*dev, proto.buffer(), fixt);
+        addArtnetFixture(*dev, &proto.buffer(), 1, fixt);
       }
 
       if(set.mode == ArtnetSpecificSettings::Sink)
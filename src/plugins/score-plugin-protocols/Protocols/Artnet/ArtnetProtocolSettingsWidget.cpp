@@ -1136,7 +1136,8 @@ public:
       updateParameters(newFixt);
     };
 
-    m_address.setRange(1, 512);
+    m_universes = std::max(1, parent.universeCount());
+    m_address.setRange(1, 512 * m_universes);
 
     m_setupLayoutContainer.addLayout(&m_setupLayout);
     m_setupLayout.addRow(tr("Name"), &m_name);
@@ -1151,6 +1152,23 @@ public:
     connect(
         &m_mode, qOverload<int>(&QComboBox::currentIndexChanged), this,
         &AddFixtureDialog::setMode);
+    connect(
+        &m_address, &QSpinBox::editingFinished, this,
+        &AddFixtureDialog::fitAddressInUniverse);
+  }
+
+  // A fixture cannot span two universes: it is moved to the next one
+  void fitAddressInUniverse()
+  {
+    const int address = m_address.value() - 1;
+    if(address % 512 + m_numChannels <= 512)
+      return;
+
+    const int next = (address / 512 + 1) * 512;
+    if(next + m_numChannels <= 512 * m_universes)
+      m_address.setValue(next + 1);
+    else
+      m_address.setValue(next - m_numChannels + 1);
   }
 
   void updateParameters(const FixtureNode& fixt)
@@ -1175,8 +1193,9 @@ public:
       return;
 
     const FixtureMode& mode = m_currentFixture->modes[mode_index];
-    int numChannels = mode.allChannels.size();
-    m_address.setRange(1, 513 - numChannels);
+    m_numChannels = std::max(1, int(mode.allChannels.size()));
+    m_address.setRange(1, 512 * m_universes + 1 - m_numChannels);
+    fitAddressInUniverse();
 
     m_content.setText(mode.content());
   }
@@ -1217,6 +1236,8 @@ private:
   QDialogButtonBox m_buttons;
 
   const FixtureData* m_currentFixture{};
+  int m_universes{1};
+  int m_numChannels{1};
 };
 
 ArtnetProtocolSettingsWidget::ArtnetProtocolSettingsWidget(QWidget* parent)
@@ -1237,6 +1258,13 @@ ArtnetProtocolSettingsWidget::ArtnetProtocolSettingsWidget(QWidget* parent)
   m_universe = new QSpinBox{this};
   m_universe->setRange(0, 65539);
 
+  m_universeCount = new QSpinBox{this};
+  m_universeCount->setRange(1, 512);
+  m_universeCount->setToolTip(
+      tr("Number of contiguous universes sent by this device. "
+         "Fixture addresses then span all the universes, e.g. 513 is the first "
+         "channel of the second universe."));
+
   m_transport = new QComboBox{this};
   m_transport->addItems({"ArtNet", "E1.31 (sACN)", "DMX USB PRO", "DMX USB PRO Mk2"});
   checkForChanges(m_transport);
@@ -1248,12 +1276,16 @@ ArtnetProtocolSettingsWidget::ArtnetProtocolSettingsWidget(QWidget* parent)
   connect(
       m_transport, qOverload<int>(&QComboBox::currentIndexChanged), this,
       &ArtnetProtocolSettingsWidget::updateHosts);
+  connect(
+      m_source, &QRadioButton::toggled, this,
+      &ArtnetProtocolSettingsWidget::updateUniverseCount);
   updateHosts(m_transport->currentIndex());
 
   auto layout = new QFormLayout;
   layout->addRow(tr("Name"), m_deviceNameEdit);
   layout->addRow(tr("Rate (Hz)"), m_rate);
   layout->addRow(tr("Universe"), m_universe);
+  layout->addRow(tr("Universe count"), m_universeCount);
   layout->addRow(tr("Transport"), m_transport);
   layout->addRow(tr("Interface"), m_host);
 
@@ -1273,6 +1305,9 @@ ArtnetProtocolSettingsWidget::ArtnetProtocolSettingsWidget(QWidget* parent)
   m_fixturesWidget->insertColumn(3);
   m_fixturesWidget->setHorizontalHeaderLabels(
       {tr("Name"), tr("Mode"), tr("Address"), tr("Channels used")});
+  connect(
+      m_universeCount, qOverload<int>(&QSpinBox::valueChanged), this,
+      &ArtnetProtocolSettingsWidget::updateTable);
 
   auto btns = new QHBoxLayout;
   m_addFixture = new QPushButton{"Add a fixture"};
@@ -1346,6 +1381,15 @@ void ArtnetProtocolSettingsWidget::updateHosts(int idx)
 
   if(m_host->currentText().isEmpty())
     m_host->setCurrentIndex(0);
+
+  updateUniverseCount();
+}
+
+void ArtnetProtocolSettingsWidget::updateUniverseCount()
+{
+  // Several universes can only be sent, over the network
+  const bool network = m_transport->currentIndex() <= 1;
+  m_universeCount->setRange(1, network && m_source->isChecked() ? 512 : 1);
 }
 
 void ArtnetProtocolSettingsWidget::updateTable()
@@ -1353,6 +1397,7 @@ void ArtnetProtocolSettingsWidget::updateTable()
   while(m_fixturesWidget->rowCount() > 0)
     m_fixturesWidget->removeRow(int(m_fixturesWidget->rowCount()) - 1);
 
+  const int channels = m_universeCount->value() * 512;
   int row = 0;
   for(auto& fixt : m_fixtures)
   {
@@ -1365,6 +1410,17 @@ void ArtnetProtocolSettingsWidget::updateTable()
     address->setFlags(Qt::ItemIsEnabled | Qt::ItemIsSelectable);
     controls->setFlags(Qt::ItemIsEnabled | Qt::ItemIsSelectable);
 
+    const int used = std::max(1, int(fixt.mode.channelNames.size()));
+    if(fixt.address + used > channels)
+    {
+      const auto tip = tr("Outside of the universes of the device: not created");
+      for(auto item : {name_item, mode_item, address, controls})
+      {
+        item->setForeground(Qt::red);
+        item->setToolTip(tip);
+      }
+    }
+
     m_fixturesWidget->insertRow(row);
     m_fixturesWidget->setItem(row, 0, name_item);
     m_fixturesWidget->setItem(row, 1, mode_item);
@@ -1376,6 +1432,11 @@ void ArtnetProtocolSettingsWidget::updateTable()
 
 ArtnetProtocolSettingsWidget::~ArtnetProtocolSettingsWidget() { }
 
+int ArtnetProtocolSettingsWidget::universeCount() const noexcept
+{
+  return m_universeCount->value();
+}
+
 Device::DeviceSettings ArtnetProtocolSettingsWidget::getSettings() const
 {
   // TODO should be = m_settings to follow the other patterns.
@@ -1404,6 +1465,7 @@ Device::DeviceSettings ArtnetProtocolSettingsWidget::getSettings() const
 
   settings.rate = this->m_rate->value();
   settings.universe = this->m_universe->value();
+  settings.universeCount = this->m_universeCount->value();
   settings.mode = this->m_source->isChecked() ? ArtnetSpecificSettings::Source
                                               : ArtnetSpecificSettings::Sink;
   s.deviceSpecificSettings = QVariant::fromValue(settings);
@@ -1436,6 +1498,7 @@ void ArtnetProtocolSettingsWidget::setSettings(const Device::DeviceSettings& set
 
   m_rate->setValue(specif.rate);
   m_universe->setValue(specif.universe);
+  m_universeCount->setValue(specif.universeCount);
   m_host->setCurrentText(specif.host);
   if(m_host->currentText().isEmpty())
     updateHosts(m_transport->currentIndex());
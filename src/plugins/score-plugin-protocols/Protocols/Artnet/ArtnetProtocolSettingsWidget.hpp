@@ -24,17 +24,20 @@ class ArtnetProtocolSettingsWidget final : public Device::ProtocolSettingsWidget
 
 public:
   explicit ArtnetProtocolSettingsWidget(QWidget* parent = nullptr);
+  int universeCount() const noexcept;
   virtual ~ArtnetProtocolSettingsWidget();
   Device::DeviceSettings getSettings() const override;
   void setSettings(const Device::DeviceSettings& settings) override;
 
 private:
   void updateHosts(int protocolindex);
+  void updateUniverseCount();
   void updateTable();
   QLineEdit* m_deviceNameEdit{};
   QComboBox* m_host{};
   QSpinBox* m_rate{};
   QSpinBox* m_universe{};
+  QSpinBox* m_universeCount{};
   QComboBox* m_transport{};
   QRadioButton* m_source{};
   QRadioButton* m_sink{};
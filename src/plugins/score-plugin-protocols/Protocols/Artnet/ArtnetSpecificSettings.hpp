@@ -63,6 +63,7 @@ struct ArtnetSpecificSettings
   QString host;
   int rate{20};
   int universe{1};
+  int universeCount{1}; // Contiguous universes starting at universe
   enum
   {
     ArtNet, // Artnet:/Channel-{}
@@ -6,6 +6,10 @@
 #include <score/serialization/JSONVisitor.hpp>
 #include <score/serialization/StdVariantSerialization.hpp>
 
+// Version of the binary format of ArtnetSpecificSettings:
+// 1: the universe count is saved
+static constexpr int32_t artnet_settings_version = 1;
+
 JSON_METADATA(Protocols::Artnet::SingleCapability, "SingleCapability")
 JSON_METADATA(std::vector<Protocols::Artnet::RangeCapability>, "RangeCapabilities")
 
@@ -190,7 +194,8 @@ void JSONWriter::write(Protocols::Artnet::Fixture& n)
 template <>
 void DataStreamReader::read(const Protocols::ArtnetSpecificSettings& n)
 {
-  m_stream << n.fixtures << n.host << n.rate << n.universe << n.transport << n.mode;
+  m_stream << n.fixtures << n.host << n.rate << n.universe << n.transport << n.mode
+           << artnet_settings_version << n.universeCount;
   insertDelimiter();
 }
 
@@ -198,6 +203,21 @@ template <>
 void DataStreamWriter::write(Protocols::ArtnetSpecificSettings& n)
 {
   m_stream >> n.fixtures >> n.host >> n.rate >> n.universe >> n.transport >> n.mode;
+
+  // Saves from before the version was written have the delimiter in its place
+  int32_t version{};
+  m_stream >> version;
+  if(version == int32_t(0xDEADBEEF))
+  {
+    n.universeCount = 1;
+    return;
+  }
+
+  if(version >= 1)
+  {
+    m_stream >> n.universeCount;
+    n.universeCount = std::max(1, n.universeCount);
+  }
   checkDelimiter();
 }
 
@@ -208,6 +228,7 @@ void JSONReader::read(const Protocols::ArtnetSpecificSettings& n)
   obj["Host"] = n.host;
   obj["Rate"] = n.rate;
   obj["Universe"] = n.universe;
+  obj["UniverseCount"] = n.universeCount;
   obj["Transport"] = n.transport;
   obj["Mode"] = n.mode;
 }
@@ -222,6 +243,8 @@ void JSONWriter::write(Protocols::ArtnetSpecificSettings& n)
   n.rate <<= obj["Rate"];
   if(auto u = obj.tryGet("Universe"))
     n.universe = u->toInt();
+  if(auto u = obj.tryGet("UniverseCount"))
+    n.universeCount = u->toInt();
   if(auto u = obj.tryGet("Transport"))
     n.transport = (decltype(n.transport))u->toInt();
   if(auto u = obj.tryGet("Mode"))
@@ -0,0 +1,296 @@
+#include <ossia/detail/config.hpp>
+#if defined(OSSIA_PROTOCOL_ARTNET)
+#include "DMXMultiUniverseProtocol.hpp"
+
+#include <ossia/network/base/device.hpp>
+#include <ossia/network/base/node_functions.hpp>
+#include <ossia/protocols/artnet/dmx_parameter.hpp>
+
+#include <boost/asio/ip/multicast.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+
+namespace Protocols
+{
+namespace
+{
+// https://art-net.org.uk/downloads/art-net.pdf
+static constexpr uint8_t artnet_id[8] = {'A', 'r', 't', '-', 'N', 'e', 't', 0};
+static constexpr uint16_t artnet_opcode_dmx = 0x5000;
+static constexpr uint16_t artnet_opcode_sync = 0x5200;
+static constexpr uint16_t artnet_protocol_version = 14;
+
+// ANSI E1.31-2018
+static constexpr uint8_t acn_packet_id[12]
+    = {0x41, 0x53, 0x43, 0x2d, 0x45, 0x31, 0x2e, 0x31, 0x37, 0x00, 0x00, 0x00};
+static constexpr uint32_t e131_vector_root_data = 0x00000004;
+static constexpr uint32_t e131_vector_root_extended = 0x00000008;
+static constexpr uint32_t e131_vector_frame_data = 0x00000002;
+static constexpr uint32_t e131_vector_frame_sync = 0x00000001;
+static constexpr int e131_data_packet_size = 126 + 512;
+static constexpr int e131_sync_packet_size = 49;
+static constexpr int e131_max_universe = 63999;
+
+static void write_u16_be(uint8_t* p, uint16_t v) noexcept
+{
+  p[0] = uint8_t(v >> 8);
+  p[1] = uint8_t(v & 0xFF);
+}
+
+static void write_u16_le(uint8_t* p, uint16_t v) noexcept
+{
+  p[0] = uint8_t(v & 0xFF);
+  p[1] = uint8_t(v >> 8);
+}
+
+static void write_u32_be(uint8_t* p, uint32_t v) noexcept
+{
+  p[0] = uint8_t(v >> 24);
+  p[1] = uint8_t((v >> 16) & 0xFF);
+  p[2] = uint8_t((v >> 8) & 0xFF);
+  p[3] = uint8_t(v & 0xFF);
+}
+
+static void write_acn_root_layer(
+    uint8_t* p, int packet_size, uint32_t vector, const std::array<uint8_t, 16>& cid)
+{
+  write_u16_be(p + 0, 0x0010);
+  write_u16_be(p + 2, 0x0000);
+  std::memcpy(p + 4, acn_packet_id, sizeof(acn_packet_id));
+  write_u16_be(p + 16, uint16_t(0x7000 | (packet_size - 16)));
+  write_u32_be(p + 18, vector);
+  std::memcpy(p + 22, cid.data(), cid.size());
+}
+}
+
+dmx_multi_universe_protocol::dmx_multi_universe_protocol(
+    ossia::net::network_context_ptr ctx, const configuration& conf)
+    : protocol_base{flags{}}
+    , m_context{std::move(ctx)}
+    , m_conf{conf}
+    , m_socket{m_context->context}
+    , m_timer{m_context->context}
+{
+  namespace ip = boost::asio::ip;
+  m_conf.universe_count = std::max(1, m_conf.universe_count);
+  m_conf.frequency = std::clamp(m_conf.frequency, 1, 44);
+
+  m_universes = std::make_unique<ossia::net::dmx_buffer[]>(m_conf.universe_count);
+  m_sequence.resize(m_conf.universe_count, 0);
+
+  // Receivers consider a source lost after a few seconds without data:
+  // refresh unchanged universes about once per second.
+  m_keepAliveTicks = m_conf.frequency;
+  m_ticksSinceLastSend.resize(m_conf.universe_count, m_keepAliveTicks);
+
+  std::random_device rd;
+  std::generate(m_cid.begin(), m_cid.end(), [&] { return uint8_t(rd()); });
+
+  ip::address_v4 local_if = ip::address_v4::any();
+  if(!m_conf.host.empty())
+    local_if = ip::make_address_v4(m_conf.host);
+
+  m_socket.open(ip::udp::v4());
+  m_socket.set_option(ip::udp::socket::reuse_address(true));
+  m_socket.bind(ip::udp::endpoint{local_if, 0});
+
+  switch(m_conf.transport)
+  {
+    case artnet:
+      m_socket.set_option(boost::asio::socket_base::broadcast(true));
+      m_broadcast = ip::udp::endpoint{ip::address_v4::broadcast(), artnet_port};
+      break;
+    case e131:
+      if(!local_if.is_unspecified())
+        m_socket.set_option(ip::multicast::outbound_interface(local_if));
+      m_socket.set_option(ip::multicast::hops(8));
+      break;
+  }
+
+  m_timer.set_delay(std::chrono::milliseconds{
+      static_cast<int>(1000.0f / static_cast<float>(m_conf.frequency))});
+}
+
+dmx_multi_universe_protocol::~dmx_multi_universe_protocol()
+{
+  m_timer.stop();
+}
+
+void dmx_multi_universe_protocol::set_device(ossia::net::device_base& dev)
+{
+  if(m_conf.autocreate)
+  {
+    auto& root = dev.get_root_node();
+    for(int u = 0; u < m_conf.universe_count; u++)
+    {
+      auto& universe_node = ossia::net::find_or_create_node(
+          root, std::to_string(m_conf.first_universe + u));
+      for(int c = 0; c < channels_per_universe; c++)
+      {
+        auto chan_node = universe_node.create_child(std::to_string(c + 1));
+        auto chan_param = std::make_unique<ossia::net::dmx_parameter>(
+            *chan_node, m_universes[u], c);
+        chan_node->set_parameter(std::move(chan_param));
+      }
+    }
+  }
+
+  m_timer.start([this] { update_function(); });
+}
+
+void dmx_multi_universe_protocol::update_function()
+{
+  bool any_sent = false;
+  for(int u = 0; u < m_conf.universe_count; u++)
+  {
+    auto& buf = m_universes[u];
+    int& ticks = m_ticksSinceLastSend[u];
+    if(!buf.dirty && ticks < m_keepAliveTicks)
+    {
+      ticks++;
+      continue;
+    }
+
+    buf.dirty = false;
+    ticks = 0;
+
+    const int size = std::min(int(buf.data.size()), channels_per_universe);
+    switch(m_conf.transport)
+    {
+      case artnet:
+        send_artnet_dmx(u, buf.data.data(), size);
+        break;
+      case e131:
+        send_e131_dmx(u, buf.data.data(), size);
+        break;
+    }
+    any_sent = true;
+  }
+
+  if(any_sent && m_conf.sync && m_conf.universe_count > 1)
+  {
+    switch(m_conf.transport)
+    {
+      case artnet:
+        send_artnet_sync();
+        break;
+      case e131:
+        send_e131_sync();
+        break;
+    }
+  }
+}
+
+void dmx_multi_universe_protocol::send_artnet_dmx(
+    int index, const uint8_t* data, int size)
+{
+  const int universe = m_conf.first_universe + index;
+  // Length must be even and in [2; 512]
+  const int length = std::clamp(size + (size % 2), 2, channels_per_universe);
+
+  uint8_t* p = m_packet.data();
+  std::memcpy(p, artnet_id, sizeof(artnet_id));
+  write_u16_le(p + 8, artnet_opcode_dmx);
+  write_u16_be(p + 10, artnet_protocol_version);
+  p[12] = ++m_sequence[index];
+  if(p[12] == 0)
+    p[12] = m_sequence[index] = 1; // 0 disables sequencing on the receiver
+  p[13] = 0;
+  p[14] = uint8_t(universe & 0xFF);
+  p[15] = uint8_t((universe >> 8) & 0x7F);
+  write_u16_be(p + 16, uint16_t(length));
+  std::memcpy(p + 18, data, size);
+  if(size < length)
+    std::memset(p + 18 + size, 0, length - size);
+
+  send(p, 18 + length, m_broadcast);
+}
+
+void dmx_multi_universe_protocol::send_artnet_sync()
+{
+  uint8_t p[14];
+  std::memcpy(p, artnet_id, sizeof(artnet_id));
+  write_u16_le(p + 8, artnet_opcode_sync);
+  write_u16_be(p + 10, artnet_protocol_version);
+  p[12] = 0;
+  p[13] = 0;
+
+  send(p, sizeof(p), m_broadcast);
+}
+
+boost::asio::ip::udp::endpoint
+dmx_multi_universe_protocol::e131_endpoint(int universe) const noexcept
+{
+  namespace ip = boost::asio::ip;
+  const ip::address_v4::bytes_type addr{
+      239, 255, uint8_t((universe >> 8) & 0xFF), uint8_t(universe & 0xFF)};
+  return ip::udp::endpoint{ip::address_v4{addr}, e131_port};
+}
+
+void dmx_multi_universe_protocol::send_e131_dmx(
+    int index, const uint8_t* data, int size)
+{
+  const int universe = std::clamp(m_conf.first_universe + index, 1, e131_max_universe);
+  // We use the universe right after the block as synchronization address
+  const int sync_universe = m_conf.sync && m_conf.universe_count > 1
+                                ? std::clamp(
+                                    m_conf.first_universe + m_conf.universe_count, 1,
+                                    e131_max_universe)
+                                : 0;
+
+  uint8_t* p = m_packet.data();
+  std::memset(p, 0, e131_data_packet_size);
+  write_acn_root_layer(p, e131_data_packet_size, e131_vector_root_data, m_cid);
+
+  // Framing layer
+  write_u16_be(p + 38, uint16_t(0x7000 | (e131_data_packet_size - 38)));
+  write_u32_be(p + 40, e131_vector_frame_data);
+  static constexpr const char source_name[] = "ossia score";
+  std::memcpy(p + 44, source_name, sizeof(source_name));
+  p[108] = 100; // Priority
+  write_u16_be(p + 109, uint16_t(sync_universe));
+  p[111] = m_sequence[index]++;
+  p[112] = 0; // Options
+  write_u16_be(p + 113, uint16_t(universe));
+
+  // DMP layer
+  write_u16_be(p + 115, uint16_t(0x7000 | (e131_data_packet_size - 115)));
+  p[117] = 0x02;
+  p[118] = 0xa1;
+  write_u16_be(p + 119, 0x0000);
+  write_u16_be(p + 121, 0x0001);
+  write_u16_be(p + 123, uint16_t(channels_per_universe + 1));
+  p[125] = 0; // START code
+  std::memcpy(p + 126, data, size);
+
+  send(p, e131_data_packet_size, e131_endpoint(universe));
+}
+
+void dmx_multi_universe_protocol::send_e131_sync()
+{
+  const int sync_universe = std::clamp(
+      m_conf.first_universe + m_conf.universe_count, 1, e131_max_universe);
+
+  uint8_t p[e131_sync_packet_size]{};
+  write_acn_root_layer(p, e131_sync_packet_size, e131_vector_root_extended, m_cid);
+
+  write_u16_be(p + 38, uint16_t(0x7000 | (e131_sync_packet_size - 38)));
+  write_u32_be(p + 40, e131_vector_frame_sync);
+  p[44] = m_syncSequence++;
+  write_u16_be(p + 45, uint16_t(sync_universe));
+
+  send(p, sizeof(p), e131_endpoint(sync_universe));
+}
+
+void dmx_multi_universe_protocol::send(
+    const uint8_t* data, std::size_t size, const boost::asio::ip::udp::endpoint& ep)
+{
+  boost::system::error_code ec;
+  m_socket.send_to(boost::asio::buffer(data, size), ep, 0, ec);
+  if(!ec)
+    m_sentPackets++;
+}
+}
+#endif
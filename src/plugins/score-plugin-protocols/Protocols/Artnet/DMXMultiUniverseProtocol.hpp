@@ -0,0 +1,107 @@
+#pragma once
+#include <ossia/detail/config.hpp>
+#if defined(OSSIA_PROTOCOL_ARTNET)
+#include <ossia/detail/timer.hpp>
+#include <ossia/network/base/protocol.hpp>
+#include <ossia/network/context.hpp>
+#include <ossia/protocols/artnet/dmx_buffer.hpp>
+
+#include <boost/asio/ip/udp.hpp>
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Protocols
+{
+/**
+ * @brief Sends a block of contiguous DMX universes from a single socket.
+ *
+ * Universe i of the block is the network universe first_universe + i.
+ * Channel addresses are absolute in the block, e.g. address 515 is channel 3
+ * of the second universe.
+ *
+ * On each tick of the sender timer, only the universes whose buffer is dirty
+ * (or which have not been sent for a second, for receivers which
+ * need a keep-alive) are transmitted, followed by an ArtSync / E1.31 sync
+ * packet so that receivers latch all the universes of a frame at once.
+ */
+class dmx_multi_universe_protocol final : public ossia::net::protocol_base
+{
+public:
+  enum transport_t
+  {
+    artnet,
+    e131
+  };
+
+  struct configuration
+  {
+    transport_t transport{artnet};
+    std::string host;    // Local interface, empty or 0.0.0.0 for any
+    int first_universe{};
+    int universe_count{1};
+    int frequency{44};
+    bool sync{true};
+    bool autocreate{}; // Create a /universe/channel node for every channel
+  };
+
+  static constexpr int channels_per_universe = 512;
+  static constexpr uint16_t artnet_port = 6454;
+  static constexpr uint16_t e131_port = 5568;
+
+  dmx_multi_universe_protocol(
+      ossia::net::network_context_ptr ctx, const configuration& conf);
+  ~dmx_multi_universe_protocol();
+
+  int universe_count() const noexcept { return m_conf.universe_count; }
+  ossia::net::dmx_buffer& universe(int index) noexcept { return m_universes[index]; }
+
+  void set_device(ossia::net::device_base& dev) override;
+
+  bool pull(ossia::net::parameter_base&) override { return false; }
+  bool push(const ossia::net::parameter_base&, const ossia::value&) override
+  {
+    return false;
+  }
+  bool push_raw(const ossia::net::full_parameter_data&) override { return false; }
+  bool observe(ossia::net::parameter_base&, bool) override { return false; }
+  bool update(ossia::net::node_base&) override { return false; }
+
+  // Number of universe packets actually sent, for diagnostics.
+  int64_t sent_packets() const noexcept { return m_sentPackets; }
+
+private:
+  void update_function();
+
+  void send_artnet_dmx(int index, const uint8_t* data, int size);
+  void send_artnet_sync();
+  void send_e131_dmx(int index, const uint8_t* data, int size);
+  void send_e131_sync();
+
+  void send(
+      const uint8_t* data, std::size_t size,
+      const boost::asio::ip::udp::endpoint& ep);
+  boost::asio::ip::udp::endpoint e131_endpoint(int universe) const noexcept;
+
+  ossia::net::network_context_ptr m_context;
+  configuration m_conf;
+
+  std::unique_ptr<ossia::net::dmx_buffer[]> m_universes;
+  std::vector<uint8_t> m_sequence;
+  std::vector<int> m_ticksSinceLastSend;
+  uint8_t m_syncSequence{};
+  int m_keepAliveTicks{};
+
+  boost::asio::ip::udp::socket m_socket;
+  boost::asio::ip::udp::endpoint m_broadcast;
+  std::array<uint8_t, 16> m_cid{};
+  std::array<uint8_t, 638> m_packet{};
+  int64_t m_sentPackets{};
+
+  ossia::timer m_timer;
+};
+}
+#endif
@@ -0,0 +1,143 @@
+#include "BinaryProtocol.hpp"
+
+#include <QCborArray>
+#include <QCborMap>
+#include <QCborStreamWriter>
+#include <QCborValue>
+
+namespace RemoteControl
+{
+namespace
+{
+struct CborValueWriter
+{
+  QCborStreamWriter& w;
+
+  void operator()(ossia::impulse) const { w.append(nullptr); }
+  void operator()(int v) const { w.append(qint64(v)); }
+  void operator()(float v) const { w.append(v); }
+  void operator()(bool v) const { w.append(v); }
+  void operator()(char v) const { w.appendTextString(&v, 1); }
+  void operator()(const std::string& v) const
+  {
+    w.appendTextString(v.data(), v.size());
+  }
+
+  template <std::size_t N>
+  void operator()(const std::array<float, N>& v) const
+  {
+    w.startArray(N);
+    for(float f : v)
+      w.append(f);
+    w.endArray();
+  }
+
+  void operator()(const std::vector<ossia::value>& v) const
+  {
+    w.startArray(v.size());
+    for(const auto& val : v)
+      val.apply(*this);
+    w.endArray();
+  }
+
+  void operator()(const ossia::value_map_type& v) const
+  {
+    w.startMap(v.size());
+    for(const auto& [k, val] : v)
+    {
+      w.appendTextString(k.data(), k.size());
+      val.apply(*this);
+    }
+    w.endMap();
+  }
+
+  void operator()() const { w.append(nullptr); }
+};
+
+static ossia::value fromCbor(const QCborValue& v)
+{
+  switch(v.type())
+  {
+    case QCborValue::Integer:
+      return int(v.toInteger());
+    case QCborValue::Double:
+      return float(v.toDouble());
+    case QCborValue::False:
+    case QCborValue::True:
+      return v.toBool();
+    case QCborValue::String:
+      return v.toString().toStdString();
+    case QCborValue::Array: {
+      std::vector<ossia::value> list;
+      for(const auto& e : v.toArray())
+        list.push_back(fromCbor(e));
+      return list;
+    }
+    case QCborValue::Map: {
+      ossia::value_map_type map;
+      for(const auto& [k, e] : v.toMap())
+        map.emplace_back(k.toString().toStdString(), fromCbor(e));
+      return map;
+    }
+    case QCborValue::Null:
+      return ossia::impulse{};
+    default:
+      return {};
+  }
+}
+}
+
+QByteArray encodeFrame(const BinaryFrame& frame)
+{
+  QByteArray data;
+  QCborStreamWriter w{&data};
+  w.startMap(2);
+
+  w.append(QLatin1String("Values"));
+  w.startMap(frame.values.size());
+  for(const auto& [addr, val] : frame.values)
+  {
+    w.append(addr.toString());
+    val.apply(CborValueWriter{w});
+  }
+  w.endMap();
+
+  w.append(QLatin1String("Intervals"));
+  w.startMap(frame.intervals.size());
+  for(const auto& [path, state] : frame.intervals)
+  {
+    w.append(path);
+    w.startArray(state.size());
+    for(double d : state)
+      w.append(d);
+    w.endArray();
+  }
+  w.endMap();
+
+  w.endMap();
+  return data;
+}
+
+std::vector<std::pair<State::Address, ossia::value>>
+decodeValues(const QByteArray& frame)
+{
+  std::vector<std::pair<State::Address, ossia::value>> ret;
+
+  const auto values = QCborValue::fromCbor(frame).toMap().value(QLatin1String("Values"));
+  for(const auto& [k, v] : values.toMap())
+  {
+    if(auto addr = State::Address::fromString(k.toString()))
+    {
+      if(auto val = fromCbor(v); val.valid())
+        ret.emplace_back(*std::move(addr), std::move(val));
+    }
+  }
+  return ret;
+}
+
+bool isBinaryFrame(const QByteArray& message) noexcept
+{
+  // CBOR maps start with the major type 5: JSON objects start with '{'
+  return !message.isEmpty() && (uint8_t(message[0]) >> 5) == 5;
+}
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include <State/Address.hpp>
+
+#include <ossia/network/value/value.hpp>
+
+#include <QByteArray>
+
+#include <array>
+#include <vector>
+
+namespace RemoteControl
+{
+/**
+ * @brief Batched binary frames, for clients following many values.
+ *
+ * A client switches to them by sending
+ * `{ "Message": "EnableBinary", "Rate": 30 }`, the rate being the maximum
+ * number of frames per second, and back with `{ "Message": "DisableBinary" }`.
+ *
+ * It then gets, instead of the "Message" and "Intervals" JSON messages,
+ * binary frames holding a CBOR map of what changed since the previous frame:
+ * @code
+ * { "Values": { "device:/address": value, ... },
+ *   "Intervals": { "object.0/path.1/": [progress, speed, gain], ... } }
+ * @endcode
+ * Values are CBOR null for impulses, numbers, booleans, strings, arrays for
+ * vectors and lists, and maps.
+ * The client can send values the same way: `{ "Values": { ... } }`.
+ * All the other messages stay JSON in both directions.
+ */
+struct BinaryFrame
+{
+  std::vector<std::pair<State::Address, ossia::value>> values;
+  std::vector<std::pair<QString, std::array<double, 3>>> intervals;
+};
+
+//! Thread-safe: meant to be called outside of the GUI thread
+QByteArray encodeFrame(const BinaryFrame& frame);
+
+//! Values of a frame sent by a client; ignores what it does not understand
+std::vector<std::pair<State::Address, ossia::value>>
+decodeValues(const QByteArray& frame);
+
+//! Whether a binary websocket message is a CBOR frame rather than JSON
+bool isBinaryFrame(const QByteArray& message) noexcept;
+}
@@ -14,12 +14,16 @@
 #include <score/model/tree/TreeNodeSerialization.hpp>
 #include <score/serialization/VisitorCommon.hpp>
 #include <score/tools/Bind.hpp>
+#include <score/tools/ThreadPool.hpp>
 
 #include <core/document/Document.hpp>
 #include <core/document/DocumentModel.hpp>
 
 #include <QBuffer>
+#include <QCoreApplication>
+#include <QPointer>
 
+#include <RemoteControl/BinaryProtocol.hpp>
 #include <RemoteControl/DocumentPlugin.hpp>
 #include <RemoteControl/Scenario/Scenario.hpp>
 #include <RemoteControl/Settings/Model.hpp>
@@ -58,6 +62,20 @@ void DocumentPlugin::timerEvent(QTimerEvent* event)
   if(receiver.clients().size() == 0)
     return;
 
+  for(auto& it : this->m_intervals)
+  {
+    if(*it.second.progress > 0.)
+    {
+      receiver.updateInterval(
+          it.second.p.unsafePath().toString(),
+          {*it.second.progress, it.second.model->duration.speed(),
+           it.second.model->outlet->gain()});
+    }
+  }
+
+  if(!receiver.hasJsonClients())
+    return;
+
   JSONReader r;
   r.stream.StartObject();
 
@@ -86,7 +104,7 @@ void DocumentPlugin::timerEvent(QTimerEvent* event)
   r.stream.EndArray();
   r.stream.EndObject();
 
-  receiver.sendMessage(r.toString());
+  receiver.sendIntervals(r.toString());
 }
 
 void DocumentPlugin::registerInterval(Scenario::IntervalModel& m)
@@ -268,26 +286,52 @@ Receiver::Receiver(const score::DocumentContext& doc, quint16 port)
         auto d = m_dev.list().findDevice(addr.device);
         if(d)
         {
-          d->valueUpdated.connect<&Receiver::on_valueUpdated>(*this);
-          d->setListening(addr, true);
+          auto& clients = m_listenedAddresses[addr];
+          if(ossia::find(clients, c) != clients.end())
+            return;
 
-          m_listenedAddresses.insert(std::make_pair(addr, c));
+          if(clients.empty())
+          {
+            // Each device notifies us once for all the addresses listened to
+            if(m_listenedDevices[addr.device]++ == 0)
+              d->valueUpdated.connect<&Receiver::on_valueUpdated>(*this);
+            d->setListening(addr, true);
+          }
+
+          clients.push_back(c);
         }
       }));
 
   m_answers.insert(std::make_pair(
-      "DisableListening", [&](const rapidjson::Value& obj, const WSClient&) {
+      "DisableListening", [&](const rapidjson::Value& obj, const WSClient& c) {
         auto it = obj.FindMember(score::StringConstant().Address);
         if(it == obj.MemberEnd())
           return;
 
-        auto addr = score::unmarshall<::State::Address>(it->value);
-        auto d = m_dev.list().findDevice(addr.device);
-        if(d)
+        stopListening(score::unmarshall<::State::Address>(it->value), c);
+      }));
+
+  m_answers.insert(std::make_pair(
+      "EnableBinary", [this](const rapidjson::Value& obj, const WSClient& c) {
+        int rate = 30;
+        if(auto it = obj.FindMember("Rate");
+           it != obj.MemberEnd() && it->value.IsNumber())
+          rate = std::clamp(int(it->value.GetDouble()), 1, 240);
+
+        auto& client = m_binaryClients[c.socket];
+        if(client.timer)
+          killTimer(client.timer);
+        else
+          client.generation = ++m_binaryGeneration;
+        client.timer = startTimer(1000 / rate, Qt::PreciseTimer);
+      }));
+
+  m_answers.insert(std::make_pair(
+      "DisableBinary", [this](const rapidjson::Value& obj, const WSClient& c) {
+        if(auto it = m_binaryClients.find(c.socket); it != m_binaryClients.end())
         {
-          d->valueUpdated.disconnect<&Receiver::on_valueUpdated>(*this);
-          d->setListening(addr, false);
-          m_listenedAddresses.erase(addr);
+          killTimer(it->second.timer);
+          m_binaryClients.erase(it);
         }
       }));
 }
@@ -414,6 +458,13 @@ void Receiver::processTextMessage(const QString& message, const WSClient& w)
 
 void Receiver::processBinaryMessage(QByteArray message, const WSClient& w)
 {
+  if(isBinaryFrame(message))
+  {
+    for(auto& [addr, val] : decodeValues(message))
+      m_dev.updateProxy.updateRemoteValue(addr, val);
+    return;
+  }
+
   auto doc = readJson(message);
   JSONWriter wr{doc};
 
@@ -450,6 +501,85 @@ void Receiver::sendMessage(const QString& str)
   }
 }
 
+void Receiver::sendIntervals(const QString& str)
+{
+  for(auto& clt : m_clients)
+  {
+    if(m_binaryClients.find(clt.socket) == m_binaryClients.end())
+      clt.socket->sendTextMessage(str);
+  }
+}
+
+void Receiver::updateInterval(const QString& path, std::array<double, 3> state)
+{
+  for(auto& [socket, client] : m_binaryClients)
+  {
+    if(auto it = client.sentIntervals.find(path);
+       it != client.sentIntervals.end() && it->second == state)
+      client.intervals.erase(path);
+    else
+      client.intervals[path] = state;
+  }
+}
+
+void Receiver::timerEvent(QTimerEvent* event)
+{
+  for(auto& [socket, client] : m_binaryClients)
+  {
+    if(client.timer == event->timerId())
+    {
+      sendFrame(socket, client);
+      return;
+    }
+  }
+}
+
+void Receiver::sendFrame(QWebSocket* socket, BinaryClient& client)
+{
+  // The changes keep being coalesced while the previous frame is being encoded
+  if(client.encoding || (client.values.empty() && client.intervals.empty()))
+    return;
+
+  BinaryFrame frame;
+  frame.values.reserve(client.values.size());
+  for(auto& [addr, val] : client.values)
+  {
+    client.sentValues[addr] = val;
+    frame.values.emplace_back(addr, std::move(val));
+  }
+  client.values.clear();
+
+  frame.intervals.reserve(client.intervals.size());
+  for(auto& [path, state] : client.intervals)
+  {
+    client.sentIntervals[path] = state;
+    frame.intervals.emplace_back(path, state);
+  }
+  client.intervals.clear();
+
+  client.encoding = true;
+  score::TaskPool::instance().post(
+      [self = QPointer<Receiver>{this}, socket = QPointer<QWebSocket>{socket},
+       generation = client.generation, frame = std::move(frame)] {
+    QMetaObject::invokeMethod(
+        qApp,
+        [self, socket, generation, data = encodeFrame(frame)] {
+      if(!self || !socket)
+        return;
+
+      // Frames encoded before the client disabled then enabled binary
+      // frames again are dropped
+      if(auto it = self->m_binaryClients.find(socket.data());
+         it != self->m_binaryClients.end() && it->second.generation == generation)
+      {
+        it->second.encoding = false;
+        socket->sendBinaryMessage(data);
+      }
+        },
+        Qt::QueuedConnection);
+  });
+}
+
 void Receiver::socketDisconnected()
 {
   QWebSocket* pClient = qobject_cast<QWebSocket*>(sender());
@@ -465,13 +595,18 @@ void Receiver::socketDisconnected()
     }
 
     {
-      auto it = ossia::find_if(m_listenedAddresses, [=](const auto& pair) {
-        if(pair.second.socket == pClient)
-          return true;
-        return false;
-      });
-      if(it != m_listenedAddresses.end())
-        m_listenedAddresses.erase(it);
+      std::vector<::State::Address> listened;
+      for(auto& [addr, clients] : m_listenedAddresses)
+        if(ossia::find(clients, clt) != clients.end())
+          listened.push_back(addr);
+      for(auto& addr : listened)
+        stopListening(addr, clt);
+    }
+
+    if(auto it = m_binaryClients.find(pClient); it != m_binaryClients.end())
+    {
+      killTimer(it->second.timer);
+      m_binaryClients.erase(it);
     }
 
     ossia::remove_erase(m_clients, clt);
@@ -482,15 +617,68 @@ void Receiver::socketDisconnected()
 void Receiver::on_valueUpdated(const ::State::Address& addr, const ossia::value& v)
 {
   auto it = m_listenedAddresses.find(addr);
-  if(it != m_listenedAddresses.end())
+  if(it == m_listenedAddresses.end())
+    return;
+
+  QString json;
+  for(const WSClient& clt : it->second)
+  {
+    if(auto bin = m_binaryClients.find(clt.socket); bin != m_binaryClients.end())
+    {
+      // Only the last value is sent, if it differs from the one sent before
+      auto& client = bin->second;
+      if(auto sent = client.sentValues.find(addr);
+         sent != client.sentValues.end() && sent->second == v)
+        client.values.erase(addr);
+      else
+        client.values[addr] = v;
+    }
+    else
+    {
+      if(json.isEmpty())
+      {
+        ::State::Message m{::State::AddressAccessor{addr}, v};
+
+        JSONObject::Serializer s;
+        s.readFrom(m);
+        s.obj[score::StringConstant().Message] = score::StringConstant().Message;
+        json = s.toString();
+      }
+      clt.socket->sendTextMessage(json);
+    }
+  }
+}
+
+void Receiver::stopListening(const ::State::Address& addr, const WSClient& client)
+{
+  auto it = m_listenedAddresses.find(addr);
+  if(it == m_listenedAddresses.end())
+    return;
+
+  auto& clients = it->second;
+  if(ossia::find(clients, client) == clients.end())
+    return;
+  ossia::remove_erase(clients, client);
+
+  if(auto bin = m_binaryClients.find(client.socket); bin != m_binaryClients.end())
   {
-    ::State::Message m{::State::AddressAccessor{addr}, v};
+    bin->second.values.erase(addr);
+    bin->second.sentValues.erase(addr);
+  }
 
-    JSONObject::Serializer s;
-    s.readFrom(m);
-    s.obj[score::StringConstant().Message] = score::StringConstant().Message;
-    QWebSocket* w = it->second.socket;
-    w->sendTextMessage(s.toString());
+  if(!clients.empty())
+    return;
+  m_listenedAddresses.erase(it);
+
+  auto d = m_dev.list().findDevice(addr.device);
+  if(!d)
+    return;
+
+  d->setListening(addr, false);
+  if(--m_listenedDevices[addr.device] == 0)
+  {
+    d->valueUpdated.disconnect<&Receiver::on_valueUpdated>(*this);
+    m_listenedDevices.erase(addr.device);
   }
 }
 
@@ -12,6 +12,8 @@
 
 #include <nano_observer.hpp>
 #include <score_plugin_remotecontrol_export.h>
+
+#include <array>
 template <typename T>
 class TreeNode;
 namespace Device
@@ -101,12 +103,39 @@ public:
 
   void sendMessage(const QString& str);
 
+  //! Sends the interval states to the clients which did not switch to binary frames
+  void sendIntervals(const QString& str);
+
+  //! Queues the state of an interval for the next binary frames
+  void updateInterval(const QString& path, std::array<double, 3> state);
+
   void socketDisconnected();
 
   const std::vector<WSClient>& clients() const noexcept { return m_clients; }
+  bool hasJsonClients() const noexcept
+  {
+    return m_clients.size() > m_binaryClients.size();
+  }
 
 private:
+  //! State of a client receiving binary frames, see BinaryProtocol.hpp
+  struct BinaryClient
+  {
+    int timer{};
+    bool encoding{};
+    int64_t generation{};
+
+    // Changes to send in the next frame, and what was last sent
+    ossia::hash_map<::State::Address, ossia::value> values;
+    ossia::hash_map<::State::Address, ossia::value> sentValues;
+    ossia::hash_map<QString, std::array<double, 3>> intervals;
+    ossia::hash_map<QString, std::array<double, 3>> sentIntervals;
+  };
+
+  void timerEvent(QTimerEvent* event) override;
+  void sendFrame(QWebSocket* socket, BinaryClient& client);
   void on_valueUpdated(const ::State::Address& addr, const ossia::value& v);
+  void stopListening(const ::State::Address& addr, const WSClient& client);
 
   QWebSocketServer m_server;
   std::vector<WSClient> m_clients;
@@ -116,7 +145,10 @@ private:
 
   score::hash_map<QString, std::function<void(const rapidjson::Value&, const WSClient&)>>
       m_answers;
-  score::hash_map<::State::Address, WSClient> m_listenedAddresses;
+  score::hash_map<::State::Address, std::vector<WSClient>> m_listenedAddresses;
+  score::hash_map<QString, int> m_listenedDevices;
+  ossia::hash_map<QWebSocket*, BinaryClient> m_binaryClients;
+  int64_t m_binaryGeneration{};
 
   std::vector<std::pair<QObject*, Handler>> m_handlers;
 };
@@ -273,6 +273,9 @@ void IntervalComponent::cleanup(const std::shared_ptr<IntervalComponent>& self)
       qDebug() << "IntervalComponent::cleanup() ! interval has already been deleted";
     }
   }
+  if(m_feedback)
+    system().feedback.remove(m_feedback);
+
   for(auto& proc : m_processes)
     proc.second->cleanup();
 
@@ -343,32 +346,30 @@ void IntervalComponent::onSetup(
 
   if(context().doc.app.applicationSettings.gui)
   {
+    // The execution thread only writes the latest state of the interval,
+    // which is applied at the GUI refresh rate.
     std::weak_ptr<IntervalComponent> weak_self = self;
-
+    FeedbackTable::Callback apply;
     if(Q_UNLIKELY(interval().graphal()))
     {
-      t.push_back([weak_self, ossia_cst, &edit = system().editionQueue] {
-        ossia_cst->set_callback(smallfun::function<void(bool, ossia::time_value), 32>{
-            [weak_self, &edit](bool running, ossia::time_value date) {
-          edit.enqueue([weak_self, running, date] {
-            if(auto self = weak_self.lock())
-              self->graph_slot_callback(running, date);
-          });
-        }});
-      });
+      apply = [weak_self](bool running, ossia::time_value date) {
+        if(auto self = weak_self.lock())
+          self->graph_slot_callback(running, date);
+      };
     }
     else
     {
-      t.push_back([weak_self, ossia_cst, &edit = system().editionQueue] {
-        ossia_cst->set_callback(smallfun::function<void(bool, ossia::time_value), 32>{
-            [weak_self, &edit](bool running, ossia::time_value date) {
-          edit.enqueue([weak_self, running, date] {
-            if(auto self = weak_self.lock())
-              self->slot_callback(running, date);
-          });
-        }});
-      });
+      apply = [weak_self](bool running, ossia::time_value date) {
+        if(auto self = weak_self.lock())
+          self->slot_callback(running, date);
+      };
     }
+    m_feedback = system().feedback.add(std::move(apply));
+
+    t.push_back([slot = m_feedback, ossia_cst] {
+      ossia_cst->set_callback(smallfun::function<void(bool, ossia::time_value), 32>{
+          [slot](bool running, ossia::time_value date) { slot->write(running, date); }});
+    });
   }
 
   // set-up the interval ports
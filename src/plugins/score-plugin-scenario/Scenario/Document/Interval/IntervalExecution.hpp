@@ -1,4 +1,5 @@
 #pragma once
+#include <Process/Execution/Feedback.hpp>
 #include <Process/Execution/ProcessComponent.hpp>
 #include <Process/TimeValue.hpp>
 
@@ -170,5 +171,8 @@ public:
   W_SLOT(slot_callback);
   void graph_slot_callback(bool running, ossia::time_value date);
   W_SLOT(graph_slot_callback);
+
+private:
+  std::shared_ptr<FeedbackTable::Slot> m_feedback;
 };
 }
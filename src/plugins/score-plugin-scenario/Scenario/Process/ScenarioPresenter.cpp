@@ -14,14 +14,19 @@
 #include <Scenario/Commands/Scenario/Creations/CreateInterval_State_Event_TimeSync.hpp>
 #include <Scenario/Commands/Scenario/Creations/CreateTimeSync_Event_State.hpp>
 #include <Scenario/Commands/Scenario/Displacement/MoveCommentBlock.hpp>
+#include <Scenario/Document/Interval/FullView/FullViewIntervalPresenter.hpp>
 #include <Scenario/Document/Interval/Graph/GraphIntervalPresenter.hpp>
 #include <Scenario/Document/State/ItemModel/MessageItemModel.hpp>
 #include <Scenario/Process/ScenarioView.hpp>
 
 #include <score/actions/ActionManager.hpp>
 
+#include <ossia/detail/algorithms.hpp>
+
 #include <QAction>
 #include <QDebug>
+#include <QGraphicsScene>
+#include <QGraphicsView>
 #include <QMenu>
 #include <QTimer>
 
@@ -222,6 +227,7 @@ QPointF ScenarioPresenter::fromScenarioPoint(const Scenario::Point& pt) const no
 void ScenarioPresenter::setWidth(qreal width, qreal defaultWidth)
 {
   m_view->setWidth(width);
+  updateVisibleIntervals();
 }
 
 void ScenarioPresenter::setHeight(qreal height)
@@ -234,6 +240,7 @@ void ScenarioPresenter::setHeight(qreal height)
       updateEventExtent(*this, ev, height);
     }
   }
+  updateVisibleIntervals();
 }
 
 void ScenarioPresenter::putToFront()
@@ -251,6 +258,7 @@ void ScenarioPresenter::putBehind()
 void ScenarioPresenter::parentGeometryChanged()
 {
   updateAllElements();
+  updateVisibleIntervals();
   m_view->update();
 }
 
@@ -260,9 +268,23 @@ void ScenarioPresenter::on_zoomRatioChanged(ZoomRatio val)
   if(val <= 0.)
     return;
 
+  // Rescaling the processes of an interval is expensive:
+  // for the ones outside of the viewport it is done when they get scrolled into it.
+  const auto area = visibleArea();
+  m_zoomPending.clear();
   for(auto& interval : m_intervals)
   {
-    interval.on_zoomRatioChanged(m_zoomRatio);
+    if(isVisible(interval, area))
+    {
+      interval.on_zoomRatioChanged(m_zoomRatio);
+    }
+    else
+    {
+      // The interval itself is cheap to rescale and must stay consistent
+      // with the scene: only its processes are deferred
+      interval.IntervalPresenter::on_zoomRatioChanged(m_zoomRatio);
+      m_zoomPending.push_back(&interval);
+    }
   }
   for(auto& interval : m_graphIntervals)
   {
@@ -395,7 +417,12 @@ void ScenarioPresenter::on_timeSyncRemoved(const TimeSyncModel& timeSync)
 void ScenarioPresenter::on_intervalRemoved(const IntervalModel& cvm)
 {
   if(Q_LIKELY(!cvm.graphal()))
+  {
+    auto& pres = m_intervals.at(cvm.id());
+    ossia::remove_erase(m_runningIntervals, &pres);
+    ossia::remove_erase(m_zoomPending, &pres);
     removeElement(m_intervals, cvm.id());
+  }
   else
     removeElement(m_graphIntervals, cvm.id());
 }
@@ -412,17 +439,89 @@ void ScenarioPresenter::on_askUpdate()
   m_view->update();
 }
 
+QRectF ScenarioPresenter::visibleArea() const noexcept
+{
+  // Only the scenario shown in the full view gets notified of scrolling,
+  // through parentGeometryChanged: nested ones are always fully updated.
+  if(!qobject_cast<FullViewIntervalPresenter*>(parent()))
+    return {};
+
+  auto scene = m_view->scene();
+  if(!scene)
+    return {};
+
+  const auto views = scene->views();
+  if(views.empty())
+    return {};
+
+  auto gv = views.front();
+  auto r = m_view->mapRectFromScene(
+      gv->mapToScene(gv->viewport()->rect()).boundingRect());
+  if(r.isEmpty())
+    return {};
+
+  const double mx = r.width() / 2.;
+  const double my = r.height() / 2.;
+  return r.adjusted(-mx, -my, mx, my);
+}
+
+bool ScenarioPresenter::isVisible(
+    const TemporalIntervalPresenter& itv, const QRectF& area) const noexcept
+{
+  if(area.isNull())
+    return true;
+
+  // Computed from the model as the view may not be rescaled yet
+  const auto& m = itv.model();
+  const auto& dur = m.duration;
+  auto end = dur.defaultDuration();
+  if(!dur.isMaxInfinite() && dur.maxDuration() > end)
+    end = dur.maxDuration();
+
+  const double x = m.date().toPixels(m_zoomRatio);
+  const double w = end.toPixels(m_zoomRatio);
+  const auto& v = *itv.view();
+  return area.intersects({x, v.y(), std::max(w, 1.), v.boundingRect().height()});
+}
+
+void ScenarioPresenter::updateVisibleIntervals()
+{
+  if(m_zoomPending.empty())
+    return;
+
+  const auto area = visibleArea();
+  auto it = std::remove_if(
+      m_zoomPending.begin(), m_zoomPending.end(),
+      [this, &area](TemporalIntervalPresenter* itv) {
+    if(!isVisible(*itv, area))
+      return false;
+    itv->on_zoomRatioChanged(m_zoomRatio);
+    return true;
+  });
+  m_zoomPending.erase(it, m_zoomPending.end());
+}
+
+void ScenarioPresenter::updateVisibleInterval(TemporalIntervalPresenter& itv)
+{
+  auto it = ossia::find(m_zoomPending, &itv);
+  if(it == m_zoomPending.end() || !isVisible(itv, visibleArea()))
+    return;
+
+  m_zoomPending.erase(it);
+  itv.on_zoomRatioChanged(m_zoomRatio);
+}
+
 void ScenarioPresenter::on_intervalExecutionTimer()
 {
-  // TODO optimize me by storing a list of the currently running intervals
   // TODO loop
-
-  for(TemporalIntervalPresenter& cst : m_intervals)
+  const auto area = visibleArea();
+  for(TemporalIntervalPresenter* itv : m_runningIntervals)
   {
-    const auto& m = cst.model();
-    if(!m.executing())
+    TemporalIntervalPresenter& cst = *itv;
+    if(!isVisible(cst, area))
       continue;
 
+    const auto& m = cst.model();
     auto& v = *cst.view();
     const auto& dur = m.duration;
 
@@ -913,6 +1012,15 @@ void ScenarioPresenter::on_intervalCreated(const IntervalModel& interval)
 
     m_viewInterface.on_intervalMoved(*cst_pres);
 
+    if(interval.executing())
+      m_runningIntervals.push_back(cst_pres);
+    con(interval, &IntervalModel::executingChanged, this, [this, cst_pres](bool b) {
+      if(b)
+        m_runningIntervals.push_back(cst_pres);
+      else
+        ossia::remove_erase(m_runningIntervals, cst_pres);
+    });
+
     con(interval, &IntervalModel::requestHeightChange, this,
         [this, &interval](double y) {
       updateIntervalVerticalPos(
@@ -924,7 +1032,8 @@ void ScenarioPresenter::on_intervalCreated(const IntervalModel& interval)
     con(endEvent, &EventModel::statusChanged, cst_pres,
         [cst_pres] { cst_pres->view()->update(); });
 
-    auto updateHeight = [this, &interval] {
+    auto updateHeight = [this, &interval, cst_pres] {
+      updateVisibleInterval(*cst_pres);
       auto h = m_view->height();
       auto& startEvent = Scenario::startEvent(interval, model());
       auto& endEvent = Scenario::endEvent(interval, model());
@@ -945,12 +1054,21 @@ void ScenarioPresenter::on_intervalCreated(const IntervalModel& interval)
 
     con(interval, &IntervalModel::slotRemoved, this, updateHeight);
 
+    // Intervals which get into the viewport for any reason get rescaled
     connect(
         cst_pres, &TemporalIntervalPresenter::heightPercentageChanged, this,
-        [this, cst_pres]() { m_viewInterface.on_intervalMoved(*cst_pres); });
+        [this, cst_pres]() {
+      m_viewInterface.on_intervalMoved(*cst_pres);
+      updateVisibleInterval(*cst_pres);
+    });
     con(interval, &IntervalModel::dateChanged, this, [this, cst_pres](const TimeVal&) {
       m_viewInterface.on_intervalMoved(*cst_pres);
+      updateVisibleInterval(*cst_pres);
     });
+    con(interval.duration, &IntervalDurations::defaultDurationChanged, this,
+        [this, cst_pres](const TimeVal&) { updateVisibleInterval(*cst_pres); });
+    con(interval.duration, &IntervalDurations::maxDurationChanged, this,
+        [this, cst_pres](const TimeVal&) { updateVisibleInterval(*cst_pres); });
     connect(
         cst_pres, &TemporalIntervalPresenter::askUpdate, this,
         &ScenarioPresenter::on_askUpdate);
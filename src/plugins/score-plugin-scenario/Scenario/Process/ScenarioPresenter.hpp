@@ -17,6 +17,8 @@
 
 #include <verdigris>
 
+#include <vector>
+
 namespace Scenario
 {
 
@@ -132,6 +134,14 @@ private:
 
   void updateAllElements();
 
+  // Area of the scenario shown in the viewport, plus a margin,
+  // in the coordinates of the scenario view. Null when not known.
+  QRectF visibleArea() const noexcept;
+  bool
+  isVisible(const TemporalIntervalPresenter& itv, const QRectF& area) const noexcept;
+  void updateVisibleIntervals();
+  void updateVisibleInterval(TemporalIntervalPresenter& itv);
+
   ZoomRatio m_zoomRatio{1};
 
   // The order of deletion matters!
@@ -145,6 +155,10 @@ private:
   IdContainer<GraphalIntervalPresenter, IntervalModel> m_graphIntervals;
   IdContainer<CommentBlockPresenter, CommentBlockModel> m_comments;
 
+  std::vector<TemporalIntervalPresenter*> m_runningIntervals;
+  // Off-screen intervals whose processes have not been rescaled yet
+  std::vector<TemporalIntervalPresenter*> m_zoomPending;
+
   ScenarioViewInterface m_viewInterface;
 
   Scenario::EditionSettings& m_editionSettings;
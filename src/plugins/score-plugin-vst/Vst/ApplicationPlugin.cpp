@@ -100,9 +100,13 @@ void ApplicationPlugin::initialize()
   auto& set = context.settings<Media::Settings::Model>();
   con(set, &Media::Settings::Model::VstPathsChanged, this,
       &ApplicationPlugin::rescanVSTs);
+}
 
+void ApplicationPlugin::afterStartup()
+{
+  // The known plug-ins are enough to load documents: the scan can wait
   if(qEnvironmentVariableIsEmpty("SCORE_DISABLE_AUDIOPLUGINS"))
-    rescanVSTs(set.getVstPaths());
+    rescanVSTs(context.settings<Media::Settings::Model>().getVstPaths());
 }
 
 void ApplicationPlugin::addInvalidVST(const QString& path)
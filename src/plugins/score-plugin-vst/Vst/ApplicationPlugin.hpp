@@ -36,6 +36,7 @@ class ApplicationPlugin
 public:
   ApplicationPlugin(const score::ApplicationContext& app);
   void initialize() override;
+  void afterStartup() override;
   ~ApplicationPlugin() override;
 
   void rescanVSTs(const QStringList&);
@@ -10,11 +10,14 @@
 #include <QApplication>
 #include <QDir>
 #include <QDirIterator>
+#include <QFileInfo>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonValue>
+#include <QSaveFile>
 #include <QSettings>
+#include <QStandardPaths>
 #include <QTimer>
 #include <QWebSocket>
 #include <QWebSocketServer>
@@ -87,6 +90,34 @@ static const QStringList default_paths = {QStringLiteral("/usr/lib/vst3")};
 static const constexpr auto default_filter = "*.vst3";
 static const constexpr auto default_format = QDir::Dirs;
 #endif
+
+static constexpr quint32 database_magic = 0x53435633; // "SCV3"
+static constexpr quint32 database_version = 1;
+
+// Updating a plug-in replaces the binary inside the bundle, which does not always
+// change the date of the bundle directory: the most recent of both is used.
+static qint64 bundleModified(const QString& path)
+{
+  const QFileInfo bundle{path};
+  qint64 modified = bundle.lastModified().toMSecsSinceEpoch();
+  if(!bundle.isDir())
+    return modified;
+
+  // Contents/<arch>-<os>/<name>.so|.vst3, or Contents/MacOS/<name>
+  const QString name = bundle.completeBaseName();
+  QDirIterator arch{path + "/Contents", QDir::Dirs | QDir::NoDotAndDotDot};
+  while(arch.hasNext())
+  {
+    const QString dir = arch.next();
+    for(const QString& file : {name + ".so", name + ".vst3", name})
+    {
+      const QFileInfo binary{dir + "/" + file};
+      if(binary.isFile())
+        modified = std::max(modified, binary.lastModified().toMSecsSinceEpoch());
+    }
+  }
+  return modified;
+}
 }
 ApplicationPlugin::ApplicationPlugin(const score::ApplicationContext& ctx)
     : score::ApplicationPlugin{ctx}
@@ -97,6 +128,10 @@ ApplicationPlugin::ApplicationPlugin(const score::ApplicationContext& ctx)
   qRegisterMetaType<AvailablePlugin>();
   qRegisterMetaType<std::vector<AvailablePlugin>>();
 
+  m_saveTimer.setSingleShot(true);
+  m_saveTimer.setInterval(1000);
+  con(m_saveTimer, &QTimer::timeout, this, [this] { saveDatabase(); });
+
 #if QT_CONFIG(process)
   m_wsServer.listen(QHostAddress::LocalHost, 37588);
   con(m_wsServer, &QWebSocketServer::newConnection, this, [this] {
@@ -112,15 +147,17 @@ ApplicationPlugin::ApplicationPlugin(const score::ApplicationContext& ctx)
 #endif
 }
 
+ApplicationPlugin::~ApplicationPlugin()
+{
+  if(m_saveTimer.isActive())
+    saveDatabase();
+}
+
 void ApplicationPlugin::initialize()
 {
   // init with the database
-  QSettings s;
-  auto val = s.value("Effect/KnownVST3");
-  if(val.canConvert<std::vector<AvailablePlugin>>())
-  {
-    vst_infos = val.value<std::vector<AvailablePlugin>>();
-  }
+  loadDatabase();
+  reindex();
 
   vstChanged();
 
@@ -128,15 +165,115 @@ void ApplicationPlugin::initialize()
   auto& set = context.settings<Media::Settings::Model>();
   con(set, &Media::Settings::Model::VstPathsChanged, this, [this] {
     vst_infos.clear();
+    reindex();
+    scheduleSave();
     rescan();
   });
+}
 
+void ApplicationPlugin::afterStartup()
+{
+  // The database is enough to load documents: the scan can wait
   if(qEnvironmentVariableIsEmpty("SCORE_DISABLE_AUDIOPLUGINS"))
   {
     rescan();
   }
 }
 
+QString ApplicationPlugin::databasePath()
+{
+  return QStandardPaths::writableLocation(QStandardPaths::CacheLocation)
+         + QStringLiteral("/vst3.db");
+}
+
+void ApplicationPlugin::loadDatabase()
+{
+  vst_infos.clear();
+
+  QFile f{databasePath()};
+  if(f.open(QIODevice::ReadOnly))
+  {
+    QDataStream s{&f};
+    quint32 magic{}, version{}, count{};
+    s >> magic >> version >> count;
+    // Each plug-in takes at least its modification date: a larger count
+    // can only come from a corrupted file
+    const qint64 max_count = (f.size() - f.pos()) / qint64(sizeof(qint64));
+    if(magic == database_magic && version == database_version
+       && s.status() == QDataStream::Ok && qint64(count) <= max_count)
+    {
+      vst_infos.reserve(count);
+      for(quint32 i = 0; i < count && s.status() == QDataStream::Ok; i++)
+      {
+        auto& plug = vst_infos.emplace_back();
+        s >> plug.modified >> plug;
+      }
+
+      if(s.status() == QDataStream::Ok)
+        return;
+    }
+
+    // A database which cannot be read is rebuilt by the next scan
+    qDebug() << "Discarding the VST3 database: " << f.fileName();
+    vst_infos.clear();
+    f.close();
+    f.remove();
+  }
+
+  // Previous versions stored the plug-ins in the settings:
+  // they are assumed to be up-to-date.
+  QSettings settings;
+  auto val = settings.value("Effect/KnownVST3");
+  if(val.canConvert<std::vector<AvailablePlugin>>())
+  {
+    vst_infos = val.value<std::vector<AvailablePlugin>>();
+    for(auto& plug : vst_infos)
+      plug.modified = bundleModified(plug.path);
+    settings.remove("Effect/KnownVST3");
+    saveDatabase();
+  }
+}
+
+void ApplicationPlugin::saveDatabase() const
+{
+  const QString path = databasePath();
+  QDir{}.mkpath(QFileInfo{path}.absolutePath());
+
+  QSaveFile f{path};
+  if(!f.open(QIODevice::WriteOnly))
+    return;
+
+  QDataStream s{&f};
+  s << database_magic << database_version << quint32(vst_infos.size());
+  for(const auto& plug : vst_infos)
+    s << plug.modified << plug;
+
+  if(!f.commit())
+    qDebug() << "Could not save the VST3 database: " << path;
+}
+
+void ApplicationPlugin::scheduleSave()
+{
+  if(!m_saveTimer.isActive())
+    m_saveTimer.start();
+}
+
+void ApplicationPlugin::reindex()
+{
+  m_classes.clear();
+  m_paths.clear();
+  for(int i = 0, N = vst_infos.size(); i < N; i++)
+    index(i);
+}
+
+void ApplicationPlugin::index(int plugin)
+{
+  const auto& plug = vst_infos[plugin];
+  m_paths.emplace(plug.path, plugin);
+  for(int i = 0, N = plug.classInfo.size(); i < N; i++)
+    m_classes.emplace(plug.classInfo[i].ID(), std::make_pair(plugin, i));
+}
+
 void ApplicationPlugin::rescan()
 {
   auto paths = default_paths;
@@ -178,13 +315,14 @@ void ApplicationPlugin::rescan(const QStringList& paths)
     }
   }
 
-  // 2. Remove plug-ins not in these paths
+  // 2. Remove plug-ins not in these paths, or which changed since they were scanned
+  const auto previous_count = vst_infos.size();
   for(auto it = vst_infos.begin(); it != vst_infos.end();)
   {
     auto new_it = newPlugins.find(it->path);
-    if(new_it != newPlugins.end())
+    if(new_it != newPlugins.end() && it->modified == bundleModified(it->path))
     {
-      // plug-in is in both set, we ignore it
+      // plug-in is in both set and did not change, we ignore it
       newPlugins.erase(new_it);
       ++it;
     }
@@ -194,6 +332,12 @@ void ApplicationPlugin::rescan(const QStringList& paths)
     }
   }
 
+  if(vst_infos.size() != previous_count)
+  {
+    reindex();
+    scheduleSave();
+  }
+
   vstChanged();
 
   // 3. Add remaining plug-ins
@@ -296,10 +440,12 @@ void ApplicationPlugin::addInvalidVST(const QString& path)
   i.path = path;
   i.name = "invalid";
   i.isValid = false;
+  i.modified = bundleModified(path);
   vst_infos.push_back(i);
+  index(vst_infos.size() - 1);
 
   // write in the database
-  QSettings{}.setValue("Effect/KnownVST3", QVariant::fromValue(vst_infos));
+  scheduleSave();
 
   vstChanged();
 }
@@ -321,6 +467,7 @@ void ApplicationPlugin::addVST(const QString& path, const QJsonObject& obj)
   i.path = path;
   i.name = obj["Name"].toString();
   i.isValid = true;
+  i.modified = bundleModified(path);
 
   const auto& classes = obj["Classes"].toArray();
   i.classInfo.reserve(classes.size());
@@ -351,9 +498,10 @@ void ApplicationPlugin::addVST(const QString& path, const QJsonObject& obj)
     return;
 
   vst_infos.push_back(std::move(i));
+  index(vst_infos.size() - 1);
 
   // write in the database
-  QSettings{}.setValue("Effect/KnownVST3", QVariant::fromValue(vst_infos));
+  scheduleSave();
 
   vstChanged();
 }
@@ -422,44 +570,35 @@ void ApplicationPlugin::scanVSTsEvent()
 std::pair<const AvailablePlugin*, const VST3::Hosting::ClassInfo*>
 ApplicationPlugin::classInfo(const VST3::UID& uid) const noexcept
 {
-  // OPTIMIZEME with a small id -> {plugin, class} cache
-  for(auto& plug : this->vst_infos)
-  {
-    for(auto& cls : plug.classInfo)
-    {
-      if(cls.ID() == uid)
-        return {&plug, &cls};
-    }
-  }
-  return {};
+  auto it = m_classes.find(uid);
+  if(it == m_classes.end())
+    return {};
+
+  auto& plug = this->vst_infos[it->second.first];
+  return {&plug, &plug.classInfo[it->second.second]};
 }
 
 QString ApplicationPlugin::pathForClass(const VST3::UID& uid) const noexcept
 {
-  // OPTIMIZEME with the same cache than above
-  for(auto& plug : this->vst_infos)
-  {
-    for(auto& cls : plug.classInfo)
-    {
-      if(cls.ID() == uid)
-        return plug.path;
-    }
-  }
-  return {};
+  auto it = m_classes.find(uid);
+  if(it == m_classes.end())
+    return {};
+
+  return this->vst_infos[it->second.first].path;
 }
 
 std::optional<VST3::UID> ApplicationPlugin::uidForPathAndClassName(
     const QString& path, const QString& cls) const noexcept
 {
-  auto it
-      = ossia::find_if(this->vst_infos, [&](auto& info) { return info.path == path; });
-  if(it == this->vst_infos.end())
+  auto it = m_paths.find(path);
+  if(it == m_paths.end())
     return {};
 
-  auto cls_it = ossia::find_if(it->classInfo, [&, n = cls.toStdString()](auto& info) {
+  auto& plug = this->vst_infos[it->second];
+  auto cls_it = ossia::find_if(plug.classInfo, [&, n = cls.toStdString()](auto& info) {
     return info.name() == n;
   });
-  if(cls_it == it->classInfo.end())
+  if(cls_it == plug.classInfo.end())
     return {};
 
   return cls_it->ID();
@@ -4,10 +4,12 @@
 #include <score/plugins/application/GUIApplicationPlugin.hpp>
 
 #include <ossia/detail/fmt.hpp>
+#include <ossia/detail/hash_map.hpp>
 #include <ossia/detail/string_map.hpp>
 
 #include <QElapsedTimer>
 #include <QProcess>
+#include <QTimer>
 #include <QWebSocketServer>
 
 #include <base/source/fstring.h>
@@ -15,6 +17,7 @@
 
 #include <memory>
 #include <stdexcept>
+#include <string_view>
 
 namespace vst3
 {
@@ -25,6 +28,18 @@ struct AvailablePlugin
   std::vector<VST3::Hosting::ClassInfo> classInfo;
 
   bool isValid{};
+
+  // Modification time of the bundle when it was scanned.
+  // Only stored in the plug-in database, see ApplicationPlugin::saveDatabase
+  qint64 modified{};
+};
+
+struct UIDHash
+{
+  std::size_t operator()(const VST3::UID& uid) const noexcept
+  {
+    return std::hash<std::string_view>{}(std::string_view{uid.data(), 16});
+  }
 };
 
 struct HostApp final : public Steinberg::Vst::IHostApplication
@@ -87,8 +102,10 @@ class ApplicationPlugin
   W_OBJECT(ApplicationPlugin)
 public:
   ApplicationPlugin(const score::ApplicationContext& ctx);
+  ~ApplicationPlugin();
 
   void initialize() override;
+  void afterStartup() override;
 
   VST3::Hosting::Module::Ptr getModule(const std::string& path);
 
@@ -124,5 +141,22 @@ public:
   HostApp m_host;
   ossia::string_map<VST3::Hosting::Module::Ptr> modules;
   std::vector<AvailablePlugin> vst_infos;
+
+  static QString databasePath();
+
+private:
+  void loadDatabase();
+  void saveDatabase() const;
+  void scheduleSave();
+
+  void reindex();
+  void index(int plugin);
+
+  // Indices in vst_infos and in its classInfo
+  ossia::hash_map<VST3::UID, std::pair<int, int>, UIDHash> m_classes;
+  ossia::hash_map<QString, int> m_paths;
+
+  // Saving is coalesced while the scanning processes report their results
+  QTimer m_saveTimer;
 };
 }
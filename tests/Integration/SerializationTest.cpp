@@ -9,6 +9,7 @@
 #include <score/model/EntitySerialization.hpp>
 #include <score/plugins/SerializableHelpers.hpp>
 #include <score/model/Entity.hpp>
+#include <score/serialization/BinaryChunks.hpp>
 #include <wobjectimpl.h>
 #include <QtTest/QTest>
 #include <score_integration.hpp>
@@ -838,6 +839,44 @@ private:
   }
   W_SLOT(DataStreamTest)
 
+  void BinaryChunksTest()
+  {
+    score::BinaryChunkWriter w;
+    w.add(score::BinaryChunk::DocumentModel, QByteArray(100000, 'a'));
+    w.add(score::BinaryChunk::DocumentPlugin, QByteArray("plugin"));
+    w.add(score::BinaryChunk::DocumentPlugin, QByteArray{});
+    const QByteArray file = w.finish();
+
+    {
+      score::BinaryChunkReader r{file};
+      QVERIFY(r.valid());
+      QVERIFY(r.verify());
+      QCOMPARE(r.chunks().size(), std::size_t(3));
+      QCOMPARE(r.chunks()[0].data, QByteArray(100000, 'a'));
+      QCOMPARE(r.chunks()[1].kind, uint32_t(score::BinaryChunk::DocumentPlugin));
+      QCOMPARE(r.chunks()[1].data, QByteArray("plugin"));
+      QVERIFY(r.chunks()[2].data.isEmpty());
+    }
+
+    // Corrupt chunk
+    {
+      QByteArray corrupt = file;
+      corrupt[corrupt.indexOf("plugin")] = 'P';
+      score::BinaryChunkReader r{corrupt};
+      QVERIFY(r.valid());
+      QVERIFY(!r.verify());
+    }
+
+    // Truncated file
+    {
+      const QByteArray truncated = file.left(file.size() / 2);
+      score::BinaryChunkReader r{truncated};
+      QVERIFY(!r.valid());
+      QVERIFY(!r.verify());
+    }
+  }
+  W_SLOT(BinaryChunksTest)
+
 private:
   const ObjectPath test_path{{"IntervalModel", {}},
                              {"IntervalModel", 0},